@@ -0,0 +1,48 @@
+# This controls the native build of engine modules used for benchmarking.
+# `make host-bench` builds them for the host and runs the benchmarks in host_bench/bench.c.
+# Pass options to the benchmark through HOST_BENCH_ARGS, e.g. HOST_BENCH_ARGS="-b baseline.txt".
+
+HOST_CC ?= cc
+HOST_BENCH_ARGS ?=
+
+HOST_BENCH_DIR := host_bench
+HOST_BENCH_BUILDDIR := $(BUILD_DIR)/host_bench
+HOST_BENCH := $(HOST_BENCH_BUILDDIR)/bench$(EXE)
+
+# Engine sources built for the host. host_bench/host.c provides everything else they link against.
+HOST_BENCH_ENGINE_SRCS := $(addprefix $(C_SUBDIR)/,task.c malloc.c sprite.c text.c fonts.c braille.c blit.c window.c bg.c dma3_manager.c gpu_regs.c)
+HOST_BENCH_SRCS := $(HOST_BENCH_ENGINE_SRCS) $(wildcard $(HOST_BENCH_DIR)/*.c)
+HOST_BENCH_OBJS := $(patsubst %.c,$(HOST_BENCH_BUILDDIR)/%.o,$(HOST_BENCH_SRCS))
+
+# host_bench/include comes first so its gba/macro.h replaces the real one.
+HOST_BENCH_CPPFLAGS := -iquote $(HOST_BENCH_DIR)/include $(INCLUDE_CPP_ARGS) -Wno-trigraphs -DMODERN=1
+# The engine keeps pointers in 32-bit variables, so the executable must not be position independent.
+HOST_BENCH_CFLAGS := -std=gnu11 -O$(O_LEVEL) -fno-pie -fno-strict-aliasing -Wno-int-to-pointer-cast -Wno-pointer-to-int-cast
+HOST_BENCH_LDFLAGS := -no-pie
+HOST_BENCH_LIBS := -lm
+
+# Cleaning doesn't require a dependency scan, building does (it needs tools and generated fonts).
+RULES_NO_SCAN += clean-host-bench
+.PHONY: host-bench
+
+host-bench: $(HOST_BENCH)
+	$(HOST_BENCH) $(HOST_BENCH_ARGS)
+
+$(HOST_BENCH): $(HOST_BENCH_OBJS)
+	$(HOST_CC) $(HOST_BENCH_LDFLAGS) -o $@ $^ $(HOST_BENCH_LIBS)
+
+$(HOST_BENCH_BUILDDIR)/%.o: %.c
+	@mkdir -p $(@D)
+	@echo "$(HOST_CC) <flags> -o $@ $<"
+	@$(HOST_CC) -E $(HOST_BENCH_CPPFLAGS) $< | $(PREPROC) -i $< charmap.txt | $(HOST_CC) $(HOST_BENCH_CFLAGS) -x c -c -o $@ -
+
+$(HOST_BENCH_BUILDDIR)/%.d: %.c
+	@mkdir -p $(@D)
+	$(SCANINC) -C $(SCANINC_CACHE) -M $@ -I $(HOST_BENCH_DIR)/include $(INCLUDE_SCANINC_ARGS) $<
+
+ifneq (,$(filter host-bench,$(MAKECMDGOALS)))
+-include $(patsubst %.c,$(HOST_BENCH_BUILDDIR)/%.d,$(HOST_BENCH_SRCS))
+endif
+
+clean-host-bench:
+	rm -rf $(HOST_BENCH_BUILDDIR)
@@ -0,0 +1,434 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "global.h"
+#include "main.h"
+#include "bg.h"
+#include "malloc.h"
+#include "sprite.h"
+#include "task.h"
+#include "text.h"
+#include "window.h"
+#include "host.h"
+
+// Micro-benchmarks for the engine hot paths, run natively against the host
+// build of the engine. Every workload is driven by a fixed-seed generator so
+// runs are comparable with each other and with a saved baseline.
+//
+// Usage: host_bench [-r RUNS] [-o OUTPUT] [-b BASELINE] [-t THRESHOLD]
+//
+// Each benchmark prints the best time per iteration over RUNS runs. With -b,
+// any benchmark more than THRESHOLD percent (default 10) slower than the
+// baseline is reported and the exit status is nonzero. -o writes the results
+// in the format -b reads.
+
+#define DEFAULT_RUNS 5
+#define DEFAULT_THRESHOLD 10.0
+
+#define BENCH_SPRITE_COUNT 64
+#define BENCH_SPRITE_TAG 0x1000
+#define BENCH_ALLOC_SLOTS 64
+
+struct Benchmark
+{
+    const char *name;
+    u32 iterations;
+    void (*setup)(void);
+    void (*run)(u32 iterations);
+    void (*teardown)(void);
+};
+
+struct BenchResult
+{
+    const char *name;
+    double nsPerIteration;
+};
+
+static u32 sRngState;
+static void *sAllocSlots[BENCH_ALLOC_SLOTS];
+static u8 sBenchWindowId;
+static u32 sTaskCounter;
+
+static const u32 sSpriteTiles[4 * TILE_SIZE_4BPP / sizeof(u32)] = {0x11111111};
+
+static const struct OamData sOamData_16x16 =
+{
+    .affineMode = ST_OAM_AFFINE_OFF,
+    .objMode = ST_OAM_OBJ_NORMAL,
+    .bpp = ST_OAM_4BPP,
+    .shape = SPRITE_SHAPE(16x16),
+    .size = SPRITE_SIZE(16x16),
+    .priority = 1,
+};
+
+static const struct SpriteTemplate sSpriteTemplate_Bench =
+{
+    .tileTag = BENCH_SPRITE_TAG,
+    .paletteTag = TAG_NONE,
+    .oam = &sOamData_16x16,
+    .anims = gDummySpriteAnimTable,
+    .images = NULL,
+    .affineAnims = gDummySpriteAffineAnimTable,
+    .callback = SpriteCallbackDummy,
+};
+
+static const struct BgTemplate sBgTemplates[] =
+{
+    {
+        .bg = 0,
+        .charBaseIndex = 0,
+        .mapBaseIndex = 31,
+        .screenSize = 0,
+        .paletteMode = 0,
+        .priority = 0,
+        .baseTile = 0
+    },
+};
+
+static const struct WindowTemplate sWindowTemplates[] =
+{
+    {
+        .bg = 0,
+        .tilemapLeft = 1,
+        .tilemapTop = 13,
+        .width = 28,
+        .height = 6,
+        .paletteNum = 15,
+        .baseBlock = 1
+    },
+    DUMMY_WIN_TEMPLATE
+};
+
+// One message box page each. A \p would leave the printer waiting for a button
+// press that never comes, so the pages are printed separately instead.
+static const u8 sText_BenchPage1[] = _("Welcome to the world of POKéMON!\nMy name is BIRCH. But everyone calls");
+static const u8 sText_BenchPage2[] = _("me the POKéMON PROFESSOR. This world is\nwidely inhabited by creatures known as");
+static const u8 sText_BenchPage3[] = _("POKéMON.");
+
+static const u8 *const sText_Bench[] = {sText_BenchPage1, sText_BenchPage2, sText_BenchPage3};
+
+// Same constants as the game's Random(), but kept separate so the workloads
+// don't depend on random.c.
+static u32 BenchRandom(void)
+{
+    sRngState = 1103515245 * sRngState + 24691;
+    return sRngState >> 16;
+}
+
+static void SetupSprites(void)
+{
+    struct SpriteSheet sheet = {sSpriteTiles, sizeof(sSpriteTiles), BENCH_SPRITE_TAG};
+    int i;
+
+    sRngState = 1;
+    ResetSpriteData();
+    LoadSpriteSheet(&sheet);
+    for (i = 0; i < BENCH_SPRITE_COUNT; i++)
+    {
+        u8 spriteId = CreateSprite(&sSpriteTemplate_Bench, BenchRandom() % DISPLAY_WIDTH, BenchRandom() % DISPLAY_HEIGHT, BenchRandom() % 256);
+        gSprites[spriteId].oam.priority = BenchRandom() % 4;
+    }
+}
+
+// Moves every sprite by a small random step each frame, the way overworld and
+// battle sprites jitter, so the priority sort sees a nearly sorted input.
+static void RunBuildOamBuffer(u32 iterations)
+{
+    while (iterations--)
+    {
+        int i;
+
+        for (i = 0; i < BENCH_SPRITE_COUNT; i++)
+        {
+            gSprites[i].x += (s16)(BenchRandom() % 5) - 2;
+            gSprites[i].y += (s16)(BenchRandom() % 5) - 2;
+        }
+        AnimateSprites();
+        BuildOamBuffer();
+    }
+}
+
+static void SetupAlloc(void)
+{
+    sRngState = 2;
+    memset(sAllocSlots, 0, sizeof(sAllocSlots));
+    InitHeap(gHeap, HEAP_SIZE);
+}
+
+// Frees or allocates a random slot each iteration. Most requests are small,
+// with the occasional window- or tilemap-sized block.
+static void RunAlloc(u32 iterations)
+{
+    while (iterations--)
+    {
+        u32 slot = BenchRandom() % BENCH_ALLOC_SLOTS;
+
+        if (sAllocSlots[slot] != NULL)
+        {
+            Free(sAllocSlots[slot]);
+            sAllocSlots[slot] = NULL;
+        }
+        else if (BenchRandom() % 16 == 0)
+        {
+            sAllocSlots[slot] = Alloc(0x200 + BenchRandom() % 0x600);
+        }
+        else
+        {
+            sAllocSlots[slot] = Alloc(4 + BenchRandom() % 124);
+        }
+    }
+}
+
+static void SetupScreenBuffers(void)
+{
+    SetupAlloc();
+    RunAlloc(1000);
+}
+
+// Loads and frees the four BG tilemap buffers of a screen, as the Pokédex
+// does for each of its pages.
+static void RunScreenBuffersAlloc(u32 iterations)
+{
+    while (iterations--)
+    {
+        void *buffers[4];
+        u32 i;
+
+        for (i = 0; i < ARRAY_COUNT(buffers); i++)
+            buffers[i] = AllocZeroed(BG_SCREEN_SIZE);
+        for (i = 0; i < ARRAY_COUNT(buffers); i++)
+            Free(buffers[i]);
+    }
+}
+
+static void RunScreenBuffersArena(u32 iterations)
+{
+    struct Arena arena;
+
+    while (iterations--)
+    {
+        u32 i;
+
+        ArenaBegin(&arena, 4 * BG_SCREEN_SIZE);
+        for (i = 0; i < 4; i++)
+            ArenaAlloc(&arena, BG_SCREEN_SIZE);
+        ArenaReset(&arena);
+    }
+}
+
+static void SetupText(void)
+{
+    InitHeap(gHeap, HEAP_SIZE);
+    ResetBgsAndClearDma3BusyFlags(0);
+    InitBgsFromTemplates(0, sBgTemplates, ARRAY_COUNT(sBgTemplates));
+    InitWindows(sWindowTemplates);
+    DeactivateAllTextPrinters();
+    SetDefaultFontsPointer();
+    sBenchWindowId = 0;
+}
+
+static void RunRenderText(u32 iterations)
+{
+    u32 i;
+
+    while (iterations--)
+    {
+        for (i = 0; i < ARRAY_COUNT(sText_Bench); i++)
+        {
+            FillWindowPixelBuffer(sBenchWindowId, PIXEL_FILL(1));
+            AddTextPrinterParameterized(sBenchWindowId, FONT_NORMAL, sText_Bench[i], 0, 1, TEXT_SKIP_DRAW, NULL);
+        }
+    }
+}
+
+static void TeardownText(void)
+{
+    FreeAllWindowBuffers();
+}
+
+static void Task_BenchCounter(u8 taskId)
+{
+    gTasks[taskId].data[0]++;
+    sTaskCounter++;
+}
+
+static void SetupTasks(void)
+{
+    int i;
+
+    sRngState = 3;
+    sTaskCounter = 0;
+    ResetTasks();
+    for (i = 0; i < NUM_TASKS; i++)
+        CreateTask(Task_BenchCounter, BenchRandom() % 0x100);
+}
+
+static void RunTasksOnly(u32 iterations)
+{
+    while (iterations--)
+        RunTasks();
+}
+
+// Replaces one task per frame, which is what screens do when they chain
+// tasks together, so CreateTask has to find a place in the priority list.
+static void RunTaskChurn(u32 iterations)
+{
+    while (iterations--)
+    {
+        DestroyTask(BenchRandom() % NUM_TASKS);
+        CreateTask(Task_BenchCounter, BenchRandom() % 0x100);
+        RunTasks();
+    }
+}
+
+static const struct Benchmark sBenchmarks[] =
+{
+    {"BuildOamBuffer", 20000, SetupSprites, RunBuildOamBuffer, NULL},
+    {"Alloc/Free", 200000, SetupAlloc, RunAlloc, NULL},
+    {"Screen buffers (Alloc)", 20000, SetupScreenBuffers, RunScreenBuffersAlloc, NULL},
+    {"Screen buffers (Arena)", 20000, SetupScreenBuffers, RunScreenBuffersArena, NULL},
+    {"RenderText", 5000, SetupText, RunRenderText, TeardownText},
+    {"RunTasks", 200000, SetupTasks, RunTasksOnly, NULL},
+    {"RunTasks (churn)", 200000, SetupTasks, RunTaskChurn, NULL},
+};
+
+static double GetTimeNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double RunBenchmark(const struct Benchmark *bench, int runs)
+{
+    double best = 0;
+    int i;
+
+    for (i = 0; i < runs; i++)
+    {
+        double start, elapsed;
+
+        bench->setup();
+        start = GetTimeNs();
+        bench->run(bench->iterations);
+        elapsed = (GetTimeNs() - start) / bench->iterations;
+        if (bench->teardown != NULL)
+            bench->teardown();
+
+        if (i == 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    return best;
+}
+
+// Baseline files have one benchmark per line: the time per iteration in
+// nanoseconds, then the benchmark name.
+static bool32 FindBaseline(FILE *fp, const char *name, double *nsPerIteration)
+{
+    char line[256];
+
+    rewind(fp);
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char *end;
+        double value = strtod(line, &end);
+
+        if (end == line || *end != ' ')
+            continue;
+        end[strcspn(end, "\r\n")] = '\0';
+        if (strcmp(end + 1, name) == 0)
+        {
+            *nsPerIteration = value;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static void Usage(void)
+{
+    fprintf(stderr, "Usage: host_bench [-r RUNS] [-o OUTPUT] [-b BASELINE] [-t THRESHOLD]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    struct BenchResult results[ARRAY_COUNT(sBenchmarks)];
+    const char *outputPath = NULL;
+    const char *baselinePath = NULL;
+    double threshold = DEFAULT_THRESHOLD;
+    int runs = DEFAULT_RUNS;
+    int numRegressions = 0;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (i + 1 >= argc)
+            Usage();
+
+        if (strcmp(argv[i], "-r") == 0)
+            runs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-o") == 0)
+            outputPath = argv[++i];
+        else if (strcmp(argv[i], "-b") == 0)
+            baselinePath = argv[++i];
+        else if (strcmp(argv[i], "-t") == 0)
+            threshold = atof(argv[++i]);
+        else
+            Usage();
+    }
+
+    if (runs < 1)
+        Usage();
+
+    HostInit();
+
+    for (i = 0; i < (int)ARRAY_COUNT(sBenchmarks); i++)
+    {
+        results[i].name = sBenchmarks[i].name;
+        results[i].nsPerIteration = RunBenchmark(&sBenchmarks[i], runs);
+        printf("%-20s %10.1f ns\n", results[i].name, results[i].nsPerIteration);
+    }
+
+    if (outputPath != NULL)
+    {
+        FILE *fp = fopen(outputPath, "w");
+
+        if (fp == NULL)
+        {
+            fprintf(stderr, "host_bench: could not write %s\n", outputPath);
+            return 1;
+        }
+        for (i = 0; i < (int)ARRAY_COUNT(results); i++)
+            fprintf(fp, "%.1f %s\n", results[i].nsPerIteration, results[i].name);
+        fclose(fp);
+    }
+
+    if (baselinePath != NULL)
+    {
+        FILE *fp = fopen(baselinePath, "r");
+
+        if (fp == NULL)
+        {
+            fprintf(stderr, "host_bench: could not read %s\n", baselinePath);
+            return 1;
+        }
+        for (i = 0; i < (int)ARRAY_COUNT(results); i++)
+        {
+            double baseline;
+
+            if (!FindBaseline(fp, results[i].name, &baseline))
+                continue;
+            if (results[i].nsPerIteration > baseline * (1 + threshold / 100))
+            {
+                printf("REGRESSION: %s took %.1f ns, baseline is %.1f ns\n", results[i].name, results[i].nsPerIteration, baseline);
+                numRegressions++;
+            }
+        }
+        fclose(fp);
+    }
+
+    return numRegressions != 0;
+}
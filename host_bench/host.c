@@ -0,0 +1,288 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "global.h"
+#include "main.h"
+#include "battle.h"
+#include "dynamic_placeholder_text_util.h"
+#include "m4a.h"
+#include "menu.h"
+#include "palette.h"
+#include "sound.h"
+#include "string_util.h"
+#include "host.h"
+
+// Stand-ins for the hardware, the BIOS and the parts of the game the host
+// build doesn't compile. Only what the benchmarked modules link against is
+// provided here; add to it when another source file joins HOST_BENCH_ENGINE_SRCS.
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE MAP_FIXED
+#endif
+
+#define PAGE_ROUND(size) (((size) + 0xFFF) & ~0xFFF)
+
+struct HostMemoryRegion
+{
+    const char *name;
+    uintptr_t address;
+    u32 size;
+};
+
+// The engine addresses I/O, palette, VRAM and OAM through fixed pointers, and
+// stores RAM pointers in 32-bit variables, so the GBA memory map is recreated
+// at its real addresses. The executable itself must be linked below 4 GiB.
+static const struct HostMemoryRegion sMemoryRegions[] =
+{
+    {"EWRAM", EWRAM_START, EWRAM_END - EWRAM_START},
+    {"IWRAM", 0x03000000, 0x8000},
+    {"IO", REG_BASE, PAGE_ROUND(0x400)},
+    {"PLTT", PLTT, PAGE_ROUND(PLTT_SIZE)},
+    {"VRAM", VRAM, VRAM_SIZE},
+    {"OAM", OAM, PAGE_ROUND(OAM_SIZE)},
+};
+
+COMMON_DATA struct Main gMain = {0};
+u32 gBattleTypeFlags;
+u8 gStringVar1[0x100];
+u8 gStringVar2[0x100];
+u8 gStringVar3[0x100];
+struct MusicPlayerInfo gMPlayInfo_BGM;
+
+static struct SaveBlock2 sSaveBlock2;
+struct SaveBlock2 *gSaveBlock2Ptr = &sSaveBlock2;
+
+void HostInit(void)
+{
+    int i;
+
+    for (i = 0; i < (int)ARRAY_COUNT(sMemoryRegions); i++)
+    {
+        const struct HostMemoryRegion *region = &sMemoryRegions[i];
+        void *mapped = mmap((void *)region->address, region->size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+        if (mapped != (void *)region->address)
+        {
+            fprintf(stderr, "host_bench: failed to map %s at 0x%08lX\n", region->name, (unsigned long)region->address);
+            exit(1);
+        }
+    }
+}
+
+void HostDmaSet(u32 dmaNum, const void *src, void *dest, u32 control)
+{
+    u16 flags = control >> 16;
+    u32 count = control & 0xFFFF;
+    int size = (flags & DMA_32BIT) ? 4 : 2;
+    int srcStep, destStep;
+    const u8 *s = src;
+    u8 *d = dest;
+
+    if (!(flags & DMA_ENABLE) || (flags & DMA_START_MASK) != DMA_START_NOW)
+        return;
+
+    if (count == 0)
+        count = (dmaNum == 3) ? 0x10000 : 0x4000;
+
+    switch (flags & (DMA_SRC_DEC | DMA_SRC_FIXED))
+    {
+    case DMA_SRC_DEC:
+        srcStep = -size;
+        break;
+    case DMA_SRC_FIXED:
+        srcStep = 0;
+        break;
+    default:
+        srcStep = size;
+        break;
+    }
+
+    switch (flags & DMA_DEST_RELOAD)
+    {
+    case DMA_DEST_DEC:
+        destStep = -size;
+        break;
+    case DMA_DEST_FIXED:
+        destStep = 0;
+        break;
+    default:
+        destStep = size;
+        break;
+    }
+
+    if (srcStep == size && destStep == size)
+    {
+        memmove(d, s, count * size);
+        return;
+    }
+
+    while (count--)
+    {
+        memcpy(d, s, size);
+        s += srcStep;
+        d += destStep;
+    }
+}
+
+// BIOS calls. The real ones live in libagbsyscall, which is ARM assembly.
+
+#undef CpuSet
+#undef CpuFastSet
+
+void CpuSet(const void *src, void *dest, u32 control)
+{
+    u32 count = control & 0x1FFFFF;
+    int size = (control & CPU_SET_32BIT) ? 4 : 2;
+    const u8 *s = src;
+    u8 *d = dest;
+
+    while (count--)
+    {
+        memcpy(d, s, size);
+        if (!(control & CPU_SET_SRC_FIXED))
+            s += size;
+        d += size;
+    }
+}
+
+void CpuFastSet(const void *src, void *dest, u32 control)
+{
+    // The hardware always transfers whole blocks of 8 words.
+    u32 count = ((control & 0x1FFFFF) + 7) & ~7;
+    u32 *d = dest;
+
+    if (control & CPU_FAST_SET_SRC_FIXED)
+    {
+        u32 value = *(const u32 *)src;
+        while (count--)
+            *d++ = value;
+    }
+    else
+    {
+        memcpy(d, src, count * 4);
+    }
+}
+
+void LZ77UnCompWram(const u32 *src, void *dest)
+{
+    const u8 *s = (const u8 *)src;
+    u8 *d = dest;
+    u32 size = src[0] >> 8;
+    u32 written = 0;
+
+    s += 4;
+    while (written < size)
+    {
+        u8 flags = *s++;
+        int i;
+
+        for (i = 0; i < 8 && written < size; i++, flags <<= 1)
+        {
+            if (flags & 0x80)
+            {
+                int length = (s[0] >> 4) + 3;
+                int distance = (((s[0] & 0xF) << 8) | s[1]) + 1;
+
+                s += 2;
+                while (length-- && written < size)
+                {
+                    d[written] = d[written - distance];
+                    written++;
+                }
+            }
+            else
+            {
+                d[written++] = *s++;
+            }
+        }
+    }
+}
+
+// The BIOS uses an 8-bit angle and a 14-bit sine table; doubles are close
+// enough for benchmarking.
+static s32 FixedSin(u16 angle)
+{
+    return (s32)lround(sin((angle >> 8) * (2 * M_PI / 256)) * 0x4000);
+}
+
+static s32 FixedCos(u16 angle)
+{
+    return (s32)lround(cos((angle >> 8) * (2 * M_PI / 256)) * 0x4000);
+}
+
+void BgAffineSet(struct BgAffineSrcData *src, struct BgAffineDstData *dest, s32 count)
+{
+    while (count-- > 0)
+    {
+        s32 sin = FixedSin(src->alpha);
+        s32 cos = FixedCos(src->alpha);
+
+        dest->pa = (src->sx * cos) >> 14;
+        dest->pb = -(src->sx * sin) >> 14;
+        dest->pc = (src->sy * sin) >> 14;
+        dest->pd = (src->sy * cos) >> 14;
+        dest->dx = src->texX - (dest->pa * src->scrX + dest->pb * src->scrY);
+        dest->dy = src->texY - (dest->pc * src->scrX + dest->pd * src->scrY);
+        src++;
+        dest++;
+    }
+}
+
+void ObjAffineSet(struct ObjAffineSrcData *src, void *dest, s32 count, s32 offset)
+{
+    u8 *d = dest;
+
+    while (count-- > 0)
+    {
+        s32 sin = FixedSin(src->rotation);
+        s32 cos = FixedCos(src->rotation);
+
+        *(s16 *)(d + offset * 0) = (src->xScale * cos) >> 14;
+        *(s16 *)(d + offset * 1) = -(src->xScale * sin) >> 14;
+        *(s16 *)(d + offset * 2) = (src->yScale * sin) >> 14;
+        *(s16 *)(d + offset * 3) = (src->yScale * cos) >> 14;
+        d += offset * 4;
+        src++;
+    }
+}
+
+// Game code outside the benchmarked modules.
+
+void LoadPalette(const void *src, u16 offset, u16 size)
+{
+    memcpy((u16 *)PLTT + offset, src, size);
+}
+
+u32 GetPlayerTextSpeed(void)
+{
+    return gSaveBlock2Ptr->optionsTextSpeed;
+}
+
+const u8 *DynamicPlaceholderTextUtil_GetPlaceholderPtr(u8 idx)
+{
+    static const u8 sEmpty[] = {EOS};
+    return sEmpty;
+}
+
+void PlayBGM(u16 songNum)
+{
+}
+
+void PlaySE(u16 songNum)
+{
+}
+
+bool8 IsSEPlaying(void)
+{
+    return FALSE;
+}
+
+void m4aMPlayStop(struct MusicPlayerInfo *mplayInfo)
+{
+}
+
+void m4aMPlayContinue(struct MusicPlayerInfo *mplayInfo)
+{
+}
@@ -0,0 +1,17 @@
+#ifndef GUARD_HOST_BENCH_GBA_MACRO_H
+#define GUARD_HOST_BENCH_GBA_MACRO_H
+
+// Shadows include/gba/macro.h for the host build. The DMA registers are plain
+// memory on the host, so writing them would do nothing; route every DMA macro
+// through HostDmaSet instead, which performs the transfer immediately.
+
+#include "../../../include/gba/macro.h"
+#include "host.h"
+
+#undef DmaSetUnchecked
+#define DmaSetUnchecked(dmaNum, src, dest, control)                                      \
+{                                                                                         \
+    HostDmaSet(dmaNum, (const void *)(uintptr_t)(src), (void *)(uintptr_t)(dest), control); \
+}
+
+#endif // GUARD_HOST_BENCH_GBA_MACRO_H
@@ -0,0 +1,14 @@
+#ifndef GUARD_HOST_BENCH_HOST_H
+#define GUARD_HOST_BENCH_HOST_H
+
+#include "gba/types.h"
+
+// Maps the GBA memory regions at their hardware addresses. Must be called
+// before any engine code runs.
+void HostInit(void);
+
+// Performs a DMA transfer the way the hardware would for an immediate start.
+// Transfers that wait for vblank, hblank or a sound FIFO are not emulated.
+void HostDmaSet(u32 dmaNum, const void *src, void *dest, u32 control);
+
+#endif // GUARD_HOST_BENCH_HOST_H
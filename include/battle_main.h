@@ -1,6 +1,8 @@
 #ifndef GUARD_BATTLE_MAIN_H
 #define GUARD_BATTLE_MAIN_H
 
+#include "constants/type_effectiveness.h"
+
 struct TrainerMoney
 {
     u8 classId;
@@ -27,6 +29,9 @@ struct MultiPartnerMenuPokemon
 #define TYPE_EFFECT_DEF_TYPE(i) ((gTypeEffectiveness[i + 1]))
 #define TYPE_EFFECT_MULTIPLIER(i) ((gTypeEffectiveness[i + 2]))
 
+// Most entries GetTypeEffectivenessEntries can return, one per defending type
+#define MAX_TYPE_EFFECTIVENESS_ENTRIES 2
+
 // defines for the gTypeEffectiveness multipliers
 #define TYPE_MUL_NO_EFFECT          0
 #define TYPE_MUL_NOT_EFFECTIVE      5
@@ -76,13 +81,14 @@ void RunBattleScriptCommands_PopCallbacksStack(void);
 void RunBattleScriptCommands(void);
 bool8 TryRunFromBattle(u8 battler);
 void SpecialStatusesClear(void);
+u8 GetTypeEffectivenessEntries(u8 atkType, u8 defType1, u8 defType2, bool32 foresight, u16 *entries);
 
 extern struct MultiPartnerMenuPokemon gMultiPartnerParty[MULTI_PARTY_SIZE];
 
 extern const struct SpriteTemplate gUnusedBattleInitSprite;
 extern const struct OamData gOamData_BattleSpriteOpponentSide;
 extern const struct OamData gOamData_BattleSpritePlayerSide;
-extern const u8 gTypeEffectiveness[336];
+extern const u8 gTypeEffectiveness[NUM_TYPE_EFFECTIVENESS_ENTRIES * 3];
 extern const u8 gTypeNames[NUMBER_OF_MON_TYPES][TYPE_NAME_LENGTH + 1];
 extern const struct TrainerMoney gTrainerMoneyTable[];
 extern const u8 gAbilityNames[][ABILITY_NAME_LENGTH + 1];
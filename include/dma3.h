@@ -46,10 +46,22 @@
 #define Dma3FillLarge16_(value, dest, size) Dma3FillLarge_(value, dest, size, 16)
 #define Dma3FillLarge32_(value, dest, size) Dma3FillLarge_(value, dest, size, 32)
 
+// Queued requests are processed from highest to lowest priority, oldest first
+// within a priority. A request that overlaps an earlier one is never moved ahead of it.
+enum
+{
+    DMA3_PRIORITY_LOW,
+    DMA3_PRIORITY_NORMAL,
+    DMA3_PRIORITY_HIGH,
+    DMA3_PRIORITY_COUNT
+};
+
 void ClearDma3Requests(void);
 void ProcessDma3Requests(void);
 s16 RequestDma3Copy(const void *src, void *dest, u16 size, u8 mode);
 s16 RequestDma3Fill(s32 value, void *dest, u16 size, u8 mode);
+s16 RequestDma3CopyWithPriority(const void *src, void *dest, u16 size, u8 mode, u8 priority);
+s16 RequestDma3FillWithPriority(s32 value, void *dest, u16 size, u8 mode, u8 priority);
 s16 CheckForSpaceForDma3Request(s16 index);
 
 #endif // GUARD_DMA3_H
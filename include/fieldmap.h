@@ -24,6 +24,7 @@
 extern struct BackupMapLayout gBackupMapLayout;
 
 u32 MapGridGetMetatileIdAt(int x, int y);
+void MapGridGetMetatileIdsInLine(int x, int y, bool32 vertical, u16 *metatileIds, u32 count);
 u32 MapGridGetMetatileBehaviorAt(int x, int y);
 void MapGridSetMetatileIdAt(int x, int y, u16 metatile);
 void MapGridSetMetatileEntryAt(int x, int y, u16 metatile);
@@ -48,6 +49,11 @@ void LoadSecondaryTilesetPalette(struct MapLayout const *mapLayout);
 void CopySecondaryTilesetToVramUsingHeap(struct MapLayout const *mapLayout);
 void CopyPrimaryTilesetToVram(struct MapLayout const *mapLayout);
 void CopySecondaryTilesetToVram(struct MapLayout const *mapLayout);
+void PrefetchMapTilesets(struct MapLayout const *mapLayout);
+void CopyPrefetchedTilesetsToVram(struct MapLayout const *mapLayout, void *tilesDest);
+void InvalidateResidentTilesets(void);
+void KeepResidentTilesetsAfterBgInit(u32 prevBgInitCount);
+void ClearVramExceptResidentTilesets(struct MapLayout const *mapLayout);
 const struct MapHeader *const GetMapHeaderFromConnection(const struct MapConnection *connection);
 const struct MapConnection *GetMapConnectionAtPos(s16 x, s16 y);
 void MapGridSetMetatileImpassabilityAt(int x, int y, bool32 impassable);
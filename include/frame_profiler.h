@@ -0,0 +1,80 @@
+#ifndef GUARD_FRAME_PROFILER_H
+#define GUARD_FRAME_PROFILER_H
+
+// Build with `make PROFILE=1` to record how many cycles each main callback,
+// task and sprite callback takes. Timer 2 and Timer 3 are cascaded into a
+// 32-bit cycle counter, so the flash timeout timer moves to Timer 1 and link
+// cable play (which needs Timer 3) is not supported in these builds.
+//
+// Records go into gFrameProfiler, a ring buffer in EWRAM. Dump EWRAM from an
+// emulator and run tools/frameprof on the dump and pokeemerald.sym to get a
+// report.
+
+#define FRAME_PROFILER_MAGIC 0x464F5250 // "PROF"
+
+#ifndef FRAME_PROFILER_NUM_ENTRIES
+#define FRAME_PROFILER_NUM_ENTRIES 1024
+#endif
+
+// Calls longer than this are recorded as this many cycles.
+#define FRAME_PROFILER_MAX_CYCLES 0xFFFFFF
+
+enum
+{
+    PROFILE_FRAME,
+    PROFILE_CALLBACK1,
+    PROFILE_CALLBACK2,
+    PROFILE_TASK,
+    PROFILE_SPRITE_CALLBACK,
+};
+
+// Entries are written when a call returns, so a call's children come before
+// it. A PROFILE_FRAME entry closes each frame; its func is the frame number
+// and its cycles don't include the time spent waiting for VBlank.
+struct FrameProfileEntry
+{
+    u32 func;
+    u32 cycles:24;
+    u32 depth:4;
+    u32 kind:4;
+};
+
+struct FrameProfiler
+{
+    u32 magic;
+    u16 numEntries;
+    u16 head; // Next entry to be written
+    u32 totalEntries;
+    u32 frameCount;
+    struct FrameProfileEntry entries[FRAME_PROFILER_NUM_ENTRIES];
+};
+
+#ifdef FRAME_PROFILER
+
+extern struct FrameProfiler gFrameProfiler;
+
+void FrameProfiler_Init(void);
+void FrameProfiler_BeginFrame(void);
+void FrameProfiler_EndFrame(void);
+u32 FrameProfiler_BeginCall(void);
+void FrameProfiler_EndCall(u32 start, const void *func, u8 kind);
+
+#define PROFILE_CALL(kind, func, call)                        \
+    do                                                        \
+    {                                                         \
+        const void *profileFunc_ = (const void *)(func);      \
+        u32 profileStart_ = FrameProfiler_BeginCall();        \
+        call;                                                 \
+        FrameProfiler_EndCall(profileStart_, profileFunc_, kind); \
+    } while (0)
+
+#else
+
+#define FrameProfiler_Init()
+#define FrameProfiler_BeginFrame()
+#define FrameProfiler_EndFrame()
+#define PROFILE_CALL(kind, func, call) call
+
+#endif // FRAME_PROFILER
+
+#endif // GUARD_FRAME_PROFILER_H
@@ -61,6 +61,9 @@
 #define OAM      0x7000000
 #define OAM_SIZE 0x400
 
+#define ROM_START 0x8000000
+#define ROM_END   (ROM_START + 0x2000000)
+
 #define ROM_HEADER_SIZE   0xC0
 
 // Dimensions of a tile in pixels
@@ -152,6 +152,10 @@ struct MapEvents
     const struct WarpEvent *warps;
     const struct CoordEvent *coordEvents;
     const struct BgEvent *bgEvents;
+    // Event indices sorted by y, then x, or NULL to search the events in order
+    const u8 *warpsByPosition;
+    const u8 *coordEventsByPosition;
+    const u8 *bgEventsByPosition;
 };
 
 struct MapConnection
@@ -13,9 +13,34 @@
 #define HEAP_SIZE 0x1C000
 extern u8 gHeap[HEAP_SIZE];
 
+struct HeapStats
+{
+    u32 heapSize;
+    u32 usedSize;         // Allocated bytes, including block headers
+    u32 highWaterMark;    // Largest usedSize since InitHeap or ResetHeapHighWaterMark
+    u32 freeSize;
+    u32 largestFreeBlock; // Largest allocation that can currently succeed
+    u16 numAllocations;
+    u16 numFreeBlocks;
+};
+
+// An arena hands out memory from large heap blocks ("chunks") and frees all of
+// it at once with ArenaReset, for buffers that live as long as a screen does.
+// Memory from an arena is zeroed and can't be passed to Free.
+struct Arena
+{
+    struct ArenaChunk *chunks; // Most recently allocated chunk first
+    u32 chunkSize;
+};
+
 void *Alloc(u32 size);
 void *AllocZeroed(u32 size);
 void Free(void *pointer);
 void InitHeap(void *heapStart, u32 heapSize);
+void GetHeapStats(struct HeapStats *stats);
+void ResetHeapHighWaterMark(void);
+void ArenaBegin(struct Arena *arena, u32 chunkSize);
+void *ArenaAlloc(struct Arena *arena, u32 size);
+void ArenaReset(struct Arena *arena);
 
 #endif // GUARD_ALLOC_H
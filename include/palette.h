@@ -54,6 +54,7 @@ struct PaletteFadeControl
 
 extern struct PaletteFadeControl gPaletteFade;
 extern u32 gPlttBufferTransferPending;
+extern u32 gPlttBufferDirtyPalettes;
 extern u8 ALIGNED(4) gPaletteDecompressionBuffer[];
 extern u16 ALIGNED(4) gPlttBufferUnfaded[PLTT_BUFFER_SIZE];
 extern u16 ALIGNED(4) gPlttBufferFaded[PLTT_BUFFER_SIZE];
@@ -80,6 +81,20 @@ void TintPalette_GrayScale2(u16 *palette, u16 count);
 void TintPalette_SepiaTone(u16 *palette, u16 count);
 void TintPalette_CustomTone(u16 *palette, u16 count, u16 rTone, u16 gTone, u16 bTone);
 
+// Flags the palettes overlapping size bytes of gPlttBufferFaded starting at color
+// offset so the next TransferPlttBuffer uploads them. The functions in palette.c
+// do this themselves; anything writing gPlttBufferFaded directly must call it.
+static inline void MarkPlttBufferDirty(u16 offset, u16 size)
+{
+    u32 first, last;
+
+    if (size == 0)
+        return;
+    first = offset / 16;
+    last = (offset + (size - 1) / sizeof(u16)) / 16;
+    gPlttBufferDirtyPalettes |= ((2u << (last - first)) - 1) << first;
+}
+
 static inline void SetBackdropFromColor(u16 color)
 {
   FillPalette(color, 0, PLTT_SIZEOF(1));
@@ -231,6 +231,19 @@ struct Pokemon
     u16 spDefense;
 };
 
+// A decrypted copy of a BoxPokemon, for code that reads many fields of the
+// same mon. See LoadBoxMonView.
+struct BoxMonView
+{
+    struct BoxPokemon boxMon;
+    struct PokemonSubstruct0 *substruct0;
+    struct PokemonSubstruct1 *substruct1;
+    struct PokemonSubstruct2 *substruct2;
+    struct PokemonSubstruct3 *substruct3;
+    bool8 isBadChecksum;
+    bool8 isSecureModified;
+};
+
 struct MonSpritesGfxManager
 {
     u32 numSprites:4;
@@ -417,6 +430,7 @@ void CalculateMonStats(struct Pokemon *mon);
 void BoxMonToMon(const struct BoxPokemon *src, struct Pokemon *dest);
 u8 GetLevelFromMonExp(struct Pokemon *mon);
 u8 GetLevelFromBoxMonExp(struct BoxPokemon *boxMon);
+u8 GetLevelFromBoxMonViewExp(struct BoxMonView *view);
 u16 GiveMoveToMon(struct Pokemon *mon, u16 move);
 u16 GiveMoveToBattleMon(struct BattlePokemon *mon, u16 move);
 void SetMonMoveSlot(struct Pokemon *mon, u16 move, u8 slot);
@@ -443,6 +457,7 @@ void SetMultiuseSpriteTemplateToTrainerFront(u16 trainerPicId, u8 battlerPositio
  * differ for matching purposes in the caller's codegen. */
 #define GetMonData(...) CAT(GetMonData, NARG_8(__VA_ARGS__))(__VA_ARGS__)
 #define GetBoxMonData(...) CAT(GetBoxMonData, NARG_8(__VA_ARGS__))(__VA_ARGS__)
+#define GetBoxMonViewData(...) CAT(GetBoxMonViewData, NARG_8(__VA_ARGS__))(__VA_ARGS__)
 u32 GetMonData3(struct Pokemon *mon, s32 field, u8 *data);
 u32 GetMonData2(struct Pokemon *mon, s32 field);
 u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data);
@@ -450,6 +465,11 @@ u32 GetBoxMonData2(struct BoxPokemon *boxMon, s32 field);
 
 void SetMonData(struct Pokemon *mon, s32 field, const void *dataArg);
 void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg);
+void LoadBoxMonView(struct BoxMonView *view, struct BoxPokemon *boxMon);
+u32 GetBoxMonViewData3(struct BoxMonView *view, s32 field, u8 *data);
+u32 GetBoxMonViewData2(struct BoxMonView *view, s32 field);
+void SetBoxMonViewData(struct BoxMonView *view, s32 field, const void *dataArg);
+void StoreBoxMonView(struct BoxMonView *view, struct BoxPokemon *boxMon);
 void CopyMon(void *dest, void *src, size_t size);
 u8 GiveMonToPlayer(struct Pokemon *mon);
 u8 CalculatePlayerPartyCount(void);
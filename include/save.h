@@ -78,6 +78,16 @@ struct SaveSector
     u32 counter;
 }; // size is SECTOR_SIZE (0x1000)
 
+// The used part of a sector's footer
+struct SaveSectorFooter
+{
+    u16 id;
+    u16 checksum;
+    u32 signature;
+    u32 counter;
+};
+
+#define SECTOR_FOOTER_OFFSET    offsetof(struct SaveSector, id)
 #define SECTOR_SIGNATURE_OFFSET offsetof(struct SaveSector, signature)
 #define SECTOR_COUNTER_OFFSET   offsetof(struct SaveSector, counter)
 
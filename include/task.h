@@ -5,6 +5,8 @@
 #define TAIL_SENTINEL 0xFF
 #define TASK_NONE TAIL_SENTINEL
 
+// Can be raised as far as 253. Creating, destroying and running tasks doesn't
+// get slower with more slots; each one costs sizeof(struct Task) + 2 bytes.
 #define NUM_TASKS 16
 #define NUM_TASK_DATA 16
 
@@ -26,6 +28,7 @@ void ResetTasks(void);
 u8 CreateTask(TaskFunc func, u8 priority);
 void DestroyTask(u8 taskId);
 void RunTasks(void);
+void SetTaskFrameSkip(u8 taskId, u8 frameSkip);
 void TaskDummy(u8 taskId);
 void SetTaskFuncWithFollowupFunc(u8 taskId, TaskFunc func, TaskFunc followupFunc);
 void SwitchTaskToFollowupFunc(u8 taskId);
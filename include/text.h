@@ -109,10 +109,12 @@ struct FontInfo
 
 extern const struct FontInfo *gFonts;
 
-struct GlyphWidthFunc
+struct GlyphWidths
 {
-    u32 fontId;
-    u32 (*func)(u16 glyphId, bool32 isJapanese);
+    const u8 *latinWidths;
+    const u8 *japaneseWidths;
+    u8 latinWidth; // Width of every glyph if latinWidths is NULL
+    u8 japaneseWidth; // Width of every glyph if japaneseWidths is NULL
 };
 
 typedef struct {
@@ -166,6 +168,5 @@ u8 GetMenuCursorDimensionByFont(u8 fontId, u8 whichDimension);
 
 // braille.c
 u16 FontFunc_Braille(struct TextPrinter *textPrinter);
-u32 GetGlyphWidth_Braille(u16 glyphId, bool32 isJapanese);
 
 #endif // GUARD_TEXT_H
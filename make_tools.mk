@@ -5,9 +5,12 @@ MAKEFLAGS += --no-print-directory
 
 # Inclusive list. If you don't want a tool to be built, don't add it here.
 TOOLS_DIR := tools
-TOOL_NAMES := bin2c gbafix gbagfx jsonproc mapjson mid2agb preproc ramscrgen rsfont scaninc wav2agb
+TOOL_NAMES := bin2c frameprof gbafix gbagfx jsonproc mapjson mid2agb preproc ramscrgen rsfont scaninc wav2agb
+# savetool includes the generated map constants, so the Makefile builds it after `generated` instead.
+EXTRA_TOOL_NAMES := savetool
 
 TOOLDIRS := $(TOOL_NAMES:%=$(TOOLS_DIR)/%)
+EXTRA_TOOLDIRS := $(EXTRA_TOOL_NAMES:%=$(TOOLS_DIR)/%)
 
 # Tool making doesnt require a pokeemerald dependency scan.
 RULES_NO_SCAN += tools check-tools clean-tools $(TOOLDIRS)
@@ -19,4 +22,4 @@ $(TOOLDIRS):
 	@$(MAKE) -C $@
 
 clean-tools:
-	@$(foreach tooldir,$(TOOLDIRS),$(MAKE) clean -C $(tooldir);)
+	@$(foreach tooldir,$(TOOLDIRS) $(EXTRA_TOOLDIRS),$(MAKE) clean -C $(tooldir);)
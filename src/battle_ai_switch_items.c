@@ -604,25 +604,21 @@ void AI_TrySwitchOrUseItem(void)
 
 static void ModulateByTypeEffectiveness(u8 atkType, u8 defType1, u8 defType2, u8 *var)
 {
-    s32 i = 0;
+    s32 i, j;
+    u16 entries[MAX_TYPE_EFFECTIVENESS_ENTRIES];
+    u8 numEntries;
 
-    while (TYPE_EFFECT_ATK_TYPE(i) != TYPE_ENDTABLE)
+    numEntries = GetTypeEffectivenessEntries(atkType, defType1, defType2, FALSE, entries);
+    for (j = 0; j < numEntries; j++)
     {
-        if (TYPE_EFFECT_ATK_TYPE(i) == TYPE_FORESIGHT)
-        {
-            i += 3;
-            continue;
-        }
-        else if (TYPE_EFFECT_ATK_TYPE(i) == atkType)
-        {
-            // Check type1.
-            if (TYPE_EFFECT_DEF_TYPE(i) == defType1)
-                *var = (*var * TYPE_EFFECT_MULTIPLIER(i)) / TYPE_MUL_NORMAL;
-            // Check type2.
-            if (TYPE_EFFECT_DEF_TYPE(i) == defType2 && defType1 != defType2)
-                *var = (*var * TYPE_EFFECT_MULTIPLIER(i)) / TYPE_MUL_NORMAL;
-        }
-        i += 3;
+        i = entries[j];
+
+        // Check type1.
+        if (TYPE_EFFECT_DEF_TYPE(i) == defType1)
+            *var = (*var * TYPE_EFFECT_MULTIPLIER(i)) / TYPE_MUL_NORMAL;
+        // Check type2.
+        if (TYPE_EFFECT_DEF_TYPE(i) == defType2 && defType1 != defType2)
+            *var = (*var * TYPE_EFFECT_MULTIPLIER(i)) / TYPE_MUL_NORMAL;
     }
 }
 
@@ -827,12 +827,14 @@ static void Task_UpdateMonBg(u8 taskId)
         gBattle_BG1_X = x + gTasks[taskId].t2_BgX;
         gBattle_BG1_Y = y + gTasks[taskId].t2_BgY;
         CpuCopy32(&gPlttBufferFaded[OBJ_PLTT_ID(battler)], &gPlttBufferFaded[BG_PLTT_ID(animBg.paletteId)], PLTT_SIZE_4BPP);
+        MarkPlttBufferDirty(BG_PLTT_ID(animBg.paletteId), PLTT_SIZE_4BPP);
     }
     else
     {
         gBattle_BG2_X = x + gTasks[taskId].t2_BgX;
         gBattle_BG2_Y = y + gTasks[taskId].t2_BgY;
         CpuCopy32(&gPlttBufferFaded[OBJ_PLTT_ID(battler)], &gPlttBufferFaded[BG_PLTT_ID(9)], PLTT_SIZE_4BPP);
+        MarkPlttBufferDirty(BG_PLTT_ID(9), PLTT_SIZE_4BPP);
     }
 }
 
@@ -3967,6 +3967,7 @@ static void AnimProtect_Step(struct Sprite *sprite)
         }
 
         gPlttBufferFaded[sprite->data[2] + 7] = savedPal;
+        MarkPlttBufferDirty(sprite->data[2] + 1, PLTT_SIZEOF(7));
     }
 
     if (sprite->data[7] > 6 && sprite->data[0] >0 && ++sprite->data[6] > 1)
@@ -5084,6 +5085,7 @@ static void AnimTask_MoonlightEndFade_Step(u8 taskId)
                 bitmask <<= 1;
                 r3 += 16;
             }
+            gPlttBufferDirtyPalettes |= (u16)task->data[3];
         }
         break;
     case 1:
@@ -5269,6 +5271,7 @@ void AnimTask_MusicNotesRainbowBlend(u8 taskId)
         index = OBJ_PLTT_ID(index);
         for (i = 1; i < ARRAY_COUNT(gParticlesColorBlendTable[0]); i++)
             gPlttBufferFaded[index + i] = gParticlesColorBlendTable[0][i];
+        MarkPlttBufferDirty(index, PLTT_SIZE_4BPP);
     }
 
     for (j = 1; j < ARRAY_COUNT(gParticlesColorBlendTable); j++)
@@ -5279,6 +5282,7 @@ void AnimTask_MusicNotesRainbowBlend(u8 taskId)
             index = OBJ_PLTT_ID(index);
             for (i = 1; i < ARRAY_COUNT(gParticlesColorBlendTable[0]); i++)
                 gPlttBufferFaded[index + i] = gParticlesColorBlendTable[j][i];
+            MarkPlttBufferDirty(index, PLTT_SIZE_4BPP);
         }
     }
     DestroyAnimVisualTask(taskId);
@@ -1769,6 +1769,7 @@ static void AnimVoidLines_Step(struct Sprite *sprite)
             gPlttBufferFaded[i + id] = gPlttBufferFaded[i + id + 1];
 
         gPlttBufferFaded[id + 15] = val;
+        MarkPlttBufferDirty(id + 8, PLTT_SIZEOF(8));
 
         if (++sprite->data[2] == 24)
             DestroyAnimSprite(sprite);
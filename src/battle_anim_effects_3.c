@@ -1388,6 +1388,7 @@ static void SetPsychicBackground_Step(u8 taskId)
             gPlttBufferFaded[BG_PLTT_ID(paletteIndex) + i + 1] = gPlttBufferFaded[BG_PLTT_ID(paletteIndex) + i];
 
         gPlttBufferFaded[BG_PLTT_ID(paletteIndex) + 1] = lastColor;
+        MarkPlttBufferDirty(BG_PLTT_ID(paletteIndex), PLTT_SIZE_4BPP);
         gTasks[taskId].data[5] = 0;
     }
 
@@ -1413,6 +1414,7 @@ static void FadeScreenToWhite_Step(u8 taskId)
         for (i = 10; i > 0; i--)
             gPlttBufferFaded[BG_PLTT_ID(paletteIndex) + i + 1] = gPlttBufferFaded[BG_PLTT_ID(paletteIndex) + i];
         gPlttBufferFaded[BG_PLTT_ID(paletteIndex) + 1] = lastColor;
+        MarkPlttBufferDirty(BG_PLTT_ID(paletteIndex), PLTT_SIZE_4BPP);
 
         lastColor = gPlttBufferUnfaded[BG_PLTT_ID(paletteIndex) + 11];
         for (i = 10; i > 0; i--)
@@ -399,6 +399,7 @@ static void AnimTask_AnimateGustTornadoPalette_Step(u8 taskId)
         } while (i > 0);
 
         gPlttBufferFaded[base + OBJ_PLTT_OFFSET + 1] = temp;
+        MarkPlttBufferDirty(base + OBJ_PLTT_OFFSET, PLTT_SIZE_4BPP);
     }
 
     if (--gTasks[taskId].data[0] == 0)
@@ -3042,6 +3042,7 @@ void SetPpNumbersPaletteInMoveSelection(void)
 
     CpuCopy16(&gPlttBufferUnfaded[BG_PLTT_ID(5) + 12], &gPlttBufferFaded[BG_PLTT_ID(5) + 12], PLTT_SIZEOF(1));
     CpuCopy16(&gPlttBufferUnfaded[BG_PLTT_ID(5) + 11], &gPlttBufferFaded[BG_PLTT_ID(5) + 11], PLTT_SIZEOF(1));
+    MarkPlttBufferDirty(BG_PLTT_ID(5), PLTT_SIZE_4BPP);
 }
 
 u8 GetCurrentPpToMaxPpState(u8 currentPp, u8 maxPp)
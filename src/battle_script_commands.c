@@ -1354,7 +1354,9 @@ static void ModulateDmgByType(u8 multiplier)
 
 static void Cmd_typecalc(void)
 {
-    s32 i = 0;
+    s32 i, j;
+    u16 entries[MAX_TYPE_EFFECTIVENESS_ENTRIES];
+    u8 numEntries;
     u8 moveType;
 
     if (gCurrentMove == MOVE_STRUGGLE)
@@ -1383,26 +1385,18 @@ static void Cmd_typecalc(void)
     }
     else
     {
-        while (TYPE_EFFECT_ATK_TYPE(i) != TYPE_ENDTABLE)
+        numEntries = GetTypeEffectivenessEntries(moveType, gBattleMons[gBattlerTarget].types[0], gBattleMons[gBattlerTarget].types[1], gBattleMons[gBattlerTarget].status2 & STATUS2_FORESIGHT, entries);
+        for (j = 0; j < numEntries; j++)
         {
-            if (TYPE_EFFECT_ATK_TYPE(i) == TYPE_FORESIGHT)
-            {
-                if (gBattleMons[gBattlerTarget].status2 & STATUS2_FORESIGHT)
-                    break;
-                i += 3;
-                continue;
-            }
-            else if (TYPE_EFFECT_ATK_TYPE(i) == moveType)
-            {
-                // check type1
-                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0])
-                    ModulateDmgByType(TYPE_EFFECT_MULTIPLIER(i));
-                // check type2
-                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1] &&
-                    gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1])
-                    ModulateDmgByType(TYPE_EFFECT_MULTIPLIER(i));
-            }
-            i += 3;
+            i = entries[j];
+
+            // check type1
+            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0])
+                ModulateDmgByType(TYPE_EFFECT_MULTIPLIER(i));
+            // check type2
+            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1] &&
+                gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1])
+                ModulateDmgByType(TYPE_EFFECT_MULTIPLIER(i));
         }
     }
 
@@ -1426,7 +1420,9 @@ static void Cmd_typecalc(void)
 static void CheckWonderGuardAndLevitate(void)
 {
     u8 flags = 0;
-    s32 i = 0;
+    s32 i, j;
+    u16 entries[MAX_TYPE_EFFECTIVENESS_ENTRIES];
+    u8 numEntries;
     u8 moveType;
 
     if (gCurrentMove == MOVE_STRUGGLE || !gBattleMoves[gCurrentMove].power)
@@ -1442,49 +1438,41 @@ static void CheckWonderGuardAndLevitate(void)
         return;
     }
 
-    while (TYPE_EFFECT_ATK_TYPE(i) != TYPE_ENDTABLE)
+    numEntries = GetTypeEffectivenessEntries(moveType, gBattleMons[gBattlerTarget].types[0], gBattleMons[gBattlerTarget].types[1], gBattleMons[gBattlerTarget].status2 & STATUS2_FORESIGHT, entries);
+    for (j = 0; j < numEntries; j++)
     {
-        if (TYPE_EFFECT_ATK_TYPE(i) == TYPE_FORESIGHT)
+        i = entries[j];
+
+        // check no effect
+        if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0]
+            && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
         {
-            if (gBattleMons[gBattlerTarget].status2 & STATUS2_FORESIGHT)
-                break;
-            i += 3;
-            continue;
+            gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
+            gProtectStructs[gBattlerAttacker].targetNotAffected = 1;
         }
-        if (TYPE_EFFECT_ATK_TYPE(i) == moveType)
+        if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1] &&
+            gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1] &&
+            TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
         {
-            // check no effect
-            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0]
-                && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
-            {
-                gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
-                gProtectStructs[gBattlerAttacker].targetNotAffected = 1;
-            }
-            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1] &&
-                gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1] &&
-                TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
-            {
-                gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
-                gProtectStructs[gBattlerAttacker].targetNotAffected = 1;
-            }
+            gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
+            gProtectStructs[gBattlerAttacker].targetNotAffected = 1;
+        }
 
-            // check super effective
-            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0] && TYPE_EFFECT_MULTIPLIER(i) == 20)
-                flags |= 1;
-            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
-             && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
-             && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_SUPER_EFFECTIVE)
-                flags |= 1;
+        // check super effective
+        if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0] && TYPE_EFFECT_MULTIPLIER(i) == 20)
+            flags |= 1;
+        if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
+         && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
+         && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_SUPER_EFFECTIVE)
+            flags |= 1;
 
-            // check not very effective
-            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0] && TYPE_EFFECT_MULTIPLIER(i) == 5)
-                flags |= 2;
-            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
-             && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
-             && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NOT_EFFECTIVE)
-                flags |= 2;
-        }
-        i += 3;
+        // check not very effective
+        if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0] && TYPE_EFFECT_MULTIPLIER(i) == 5)
+            flags |= 2;
+        if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
+         && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
+         && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NOT_EFFECTIVE)
+            flags |= 2;
     }
 
     if (gBattleMons[gBattlerTarget].ability == ABILITY_WONDER_GUARD && AttacksThisTurn(gBattlerAttacker, gCurrentMove) == 2)
@@ -1535,7 +1523,9 @@ static void ModulateDmgByType2(u8 multiplier, u16 move, u8 *flags)
 
 u8 TypeCalc(u16 move, u8 attacker, u8 defender)
 {
-    s32 i = 0;
+    s32 i, j;
+    u16 entries[MAX_TYPE_EFFECTIVENESS_ENTRIES];
+    u8 numEntries;
     u8 flags = 0;
     u8 moveType;
 
@@ -1557,27 +1547,18 @@ u8 TypeCalc(u16 move, u8 attacker, u8 defender)
     }
     else
     {
-        while (TYPE_EFFECT_ATK_TYPE(i) != TYPE_ENDTABLE)
+        numEntries = GetTypeEffectivenessEntries(moveType, gBattleMons[defender].types[0], gBattleMons[defender].types[1], gBattleMons[defender].status2 & STATUS2_FORESIGHT, entries);
+        for (j = 0; j < numEntries; j++)
         {
-            if (TYPE_EFFECT_ATK_TYPE(i) == TYPE_FORESIGHT)
-            {
-                if (gBattleMons[defender].status2 & STATUS2_FORESIGHT)
-                    break;
-                i += 3;
-                continue;
-            }
+            i = entries[j];
 
-            else if (TYPE_EFFECT_ATK_TYPE(i) == moveType)
-            {
-                // check type1
-                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[defender].types[0])
-                    ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
-                // check type2
-                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[defender].types[1] &&
-                    gBattleMons[defender].types[0] != gBattleMons[defender].types[1])
-                    ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
-            }
-            i += 3;
+            // check type1
+            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[defender].types[0])
+                ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
+            // check type2
+            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[defender].types[1] &&
+                gBattleMons[defender].types[0] != gBattleMons[defender].types[1])
+                ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
         }
     }
 
@@ -1593,7 +1574,9 @@ u8 TypeCalc(u16 move, u8 attacker, u8 defender)
 
 u8 AI_TypeCalc(u16 move, u16 targetSpecies, u8 targetAbility)
 {
-    s32 i = 0;
+    s32 i, j;
+    u16 entries[MAX_TYPE_EFFECTIVENESS_ENTRIES];
+    u8 numEntries;
     u8 flags = 0;
     u8 type1 = gSpeciesInfo[targetSpecies].types[0], type2 = gSpeciesInfo[targetSpecies].types[1];
     u8 moveType;
@@ -1609,23 +1592,17 @@ u8 AI_TypeCalc(u16 move, u16 targetSpecies, u8 targetAbility)
     }
     else
     {
-        while (TYPE_EFFECT_ATK_TYPE(i) != TYPE_ENDTABLE)
+        numEntries = GetTypeEffectivenessEntries(moveType, type1, type2, FALSE, entries);
+        for (j = 0; j < numEntries; j++)
         {
-            if (TYPE_EFFECT_ATK_TYPE(i) == TYPE_FORESIGHT)
-            {
-                i += 3;
-                continue;
-            }
-            if (TYPE_EFFECT_ATK_TYPE(i) == moveType)
-            {
-                // check type1
-                if (TYPE_EFFECT_DEF_TYPE(i) == type1)
-                    ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
-                // check type2
-                if (TYPE_EFFECT_DEF_TYPE(i) == type2 && type1 != type2)
-                    ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
-            }
-            i += 3;
+            i = entries[j];
+
+            // check type1
+            if (TYPE_EFFECT_DEF_TYPE(i) == type1)
+                ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
+            // check type2
+            if (TYPE_EFFECT_DEF_TYPE(i) == type2 && type1 != type2)
+                ModulateDmgByType2(TYPE_EFFECT_MULTIPLIER(i), move, &flags);
         }
     }
     if (targetAbility == ABILITY_WONDER_GUARD
@@ -4500,7 +4477,9 @@ static void Cmd_moveend(void)
 static void Cmd_typecalc2(void)
 {
     u8 flags = 0;
-    s32 i = 0;
+    s32 i, j;
+    u16 entries[MAX_TYPE_EFFECTIVENESS_ENTRIES];
+    u8 numEntries;
     u8 moveType = gBattleMoves[gCurrentMove].type;
 
     if (gBattleMons[gBattlerTarget].ability == ABILITY_LEVITATE && moveType == TYPE_GROUND)
@@ -4513,64 +4492,50 @@ static void Cmd_typecalc2(void)
     }
     else
     {
-        while (TYPE_EFFECT_ATK_TYPE(i) != TYPE_ENDTABLE)
+        numEntries = GetTypeEffectivenessEntries(moveType, gBattleMons[gBattlerTarget].types[0], gBattleMons[gBattlerTarget].types[1], gBattleMons[gBattlerTarget].status2 & STATUS2_FORESIGHT, entries);
+        for (j = 0; j < numEntries; j++)
         {
-            if (TYPE_EFFECT_ATK_TYPE(i) == TYPE_FORESIGHT)
+            i = entries[j];
+
+            // check type1
+            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0])
             {
-                if (gBattleMons[gBattlerTarget].status2 & STATUS2_FORESIGHT)
+                if (TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
                 {
+                    gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
                     break;
                 }
-                else
+                if (TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NOT_EFFECTIVE)
                 {
-                    i += 3;
-                    continue;
+                    flags |= MOVE_RESULT_NOT_VERY_EFFECTIVE;
+                }
+                if (TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_SUPER_EFFECTIVE)
+                {
+                    flags |= MOVE_RESULT_SUPER_EFFECTIVE;
                 }
             }
-
-            if (TYPE_EFFECT_ATK_TYPE(i) == moveType)
+            // check type2
+            if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1])
             {
-                // check type1
-                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[0])
+                if (gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
+                    && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
                 {
-                    if (TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
-                    {
-                        gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
-                        break;
-                    }
-                    if (TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NOT_EFFECTIVE)
-                    {
-                        flags |= MOVE_RESULT_NOT_VERY_EFFECTIVE;
-                    }
-                    if (TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_SUPER_EFFECTIVE)
-                    {
-                        flags |= MOVE_RESULT_SUPER_EFFECTIVE;
-                    }
+                    gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
+                    break;
                 }
-                // check type2
-                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1])
+                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
+                    && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
+                    && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NOT_EFFECTIVE)
                 {
-                    if (gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
-                        && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NO_EFFECT)
-                    {
-                        gMoveResultFlags |= MOVE_RESULT_DOESNT_AFFECT_FOE;
-                        break;
-                    }
-                    if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
-                        && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
-                        && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_NOT_EFFECTIVE)
-                    {
-                        flags |= MOVE_RESULT_NOT_VERY_EFFECTIVE;
-                    }
-                    if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
-                        && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
-                        && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_SUPER_EFFECTIVE)
-                    {
-                        flags |= MOVE_RESULT_SUPER_EFFECTIVE;
-                    }
+                    flags |= MOVE_RESULT_NOT_VERY_EFFECTIVE;
+                }
+                if (TYPE_EFFECT_DEF_TYPE(i) == gBattleMons[gBattlerTarget].types[1]
+                    && gBattleMons[gBattlerTarget].types[0] != gBattleMons[gBattlerTarget].types[1]
+                    && TYPE_EFFECT_MULTIPLIER(i) == TYPE_MUL_SUPER_EFFECTIVE)
+                {
+                    flags |= MOVE_RESULT_SUPER_EFFECTIVE;
                 }
             }
-            i += 3;
         }
     }
 
@@ -4506,6 +4506,7 @@ static bool8 FrontierSquares_Shrink(struct Task *task)
                 gPlttBufferUnfaded[i] = RGB_BLACK;
                 gPlttBufferFaded[i] = RGB_BLACK;
             }
+            MarkPlttBufferDirty(BG_PLTT_ID(15), PLTT_SIZE_4BPP);
             break;
         case 1:
             BlendPalettes(PALETTES_ALL & ~(1 << 15), 16, RGB_BLACK);
@@ -34,6 +34,8 @@ struct BgConfig2
     u32 unk_3:18;
 
     void *tilemap;
+    u32 tilemapDirtyRows;
+    bool32 tilemapFullUploads;
     s32 bg_x;
     s32 bg_y;
 };
@@ -41,12 +43,21 @@ struct BgConfig2
 static struct BgControl sGpuBgConfigs;
 static struct BgConfig2 sGpuBgConfigs2[NUM_BACKGROUNDS];
 static u32 sDmaBusyBitfield[NUM_BACKGROUNDS];
+static u32 sBgTemplateInitCount;
 
 COMMON_DATA u32 gWindowTileAutoAllocEnabled = 0;
 
 static const struct BgConfig sZeroedBgControlStruct = { 0 };
 
+// The tilemap buffer is split into 32 equal rows for dirty tracking. For a
+// 256x256 text background this is one row of tiles.
+#define TILEMAP_DIRTY_ROWS 32
+#define TILEMAP_ALL_ROWS_DIRTY 0xFFFFFFFF
+
 static u32 GetBgType(u8 bg);
+static u16 GetBgTilemapBufferSize(u8 bg);
+static void MarkTilemapBufferRangeDirty(u8 bg, u32 offset, u32 size);
+static void MarkTilemapBufferRectDirty(u8 bg, u32 x, u32 y, u32 width, u32 height);
 
 void ResetBgs(void)
 {
@@ -57,6 +68,12 @@ void ResetBgs(void)
 
 static void SetBgModeInternal(u8 bgMode)
 {
+    int i;
+
+    // The mode decides which backgrounds are affine, which changes the tilemap layout.
+    for (i = 0; i < NUM_BACKGROUNDS; i++)
+        sGpuBgConfigs2[i].tilemapDirtyRows = TILEMAP_ALL_ROWS_DIRTY;
+
     sGpuBgConfigs.bgVisibilityAndMode &= ~0x7;
     sGpuBgConfigs.bgVisibilityAndMode |= bgMode;
 }
@@ -108,11 +125,13 @@ static void SetBgControlAttributes(u8 bg, u8 charBaseIndex, u8 mapBaseIndex, u8
         if (mapBaseIndex != 0xFF)
         {
             sGpuBgConfigs.configs[bg].mapBaseIndex = mapBaseIndex;
+            sGpuBgConfigs2[bg].tilemapDirtyRows = TILEMAP_ALL_ROWS_DIRTY;
         }
 
         if (screenSize != 0xFF)
         {
             sGpuBgConfigs.configs[bg].screenSize = screenSize;
+            sGpuBgConfigs2[bg].tilemapDirtyRows = TILEMAP_ALL_ROWS_DIRTY;
         }
 
         if (paletteMode != 0xFF)
@@ -314,6 +333,7 @@ void InitBgsFromTemplates(u8 bgMode, const struct BgTemplate *templates, u8 numT
     int i;
     u8 bg;
 
+    sBgTemplateInitCount++;
     SetBgModeInternal(bgMode);
     ResetBgControlStructs();
 
@@ -346,6 +366,7 @@ void InitBgFromTemplate(const struct BgTemplate *template)
 {
     u8 bg = template->bg;
 
+    sBgTemplateInitCount++;
     if (bg < NUM_BACKGROUNDS)
     {
         SetBgControlAttributes(bg,
@@ -367,6 +388,14 @@ void InitBgFromTemplate(const struct BgTemplate *template)
     }
 }
 
+// Counts how many times backgrounds have been set up from templates. Screens
+// that load their own BG graphics all do this first, so a caller can compare
+// counts to tell whether BG VRAM may have been overwritten since it last looked.
+u32 GetBgTemplateInitCount(void)
+{
+    return sBgTemplateInitCount;
+}
+
 void SetBgMode(u8 bgMode)
 {
     SetBgModeInternal(bgMode);
@@ -412,6 +441,9 @@ u16 LoadBgTilemap(u8 bg, const void *src, u16 size, u16 destOffset)
 
     sDmaBusyBitfield[cursor / 0x20] |= (1 << (cursor % 0x20));
 
+    // VRAM no longer matches the tilemap buffer here
+    MarkTilemapBufferRangeDirty(bg, destOffset * 2, size);
+
     return cursor;
 }
 
@@ -422,7 +454,7 @@ u16 Unused_LoadBgPalette(u8 bg, const void *src, u16 size, u16 destOffset)
     if (!IsInvalidBg32(bg))
     {
         u16 paletteOffset = PLTT_OFFSET_4BPP(sGpuBgConfigs2[bg].basePalette) + (destOffset * 2);
-        cursor = RequestDma3Copy(src, (void *)(paletteOffset + BG_PLTT), size, 0);
+        cursor = RequestDma3CopyWithPriority(src, (void *)(paletteOffset + BG_PLTT), size, 0, DMA3_PRIORITY_HIGH);
 
         if (cursor == -1)
             return -1;
@@ -850,9 +882,30 @@ void SetBgTilemapBuffer(u8 bg, void *tilemap)
     if (!IsInvalidBg32(bg) && GetBgControlAttribute(bg, BG_CTRL_ATTR_VISIBLE))
     {
         sGpuBgConfigs2[bg].tilemap = tilemap;
+        sGpuBgConfigs2[bg].tilemapDirtyRows = TILEMAP_ALL_ROWS_DIRTY;
+
+        // The caller owns this buffer and may write to it directly, so it has
+        // to be uploaded whole unless the caller opts into dirty tracking.
+        sGpuBgConfigs2[bg].tilemapFullUploads = TRUE;
     }
 }
 
+// When enabled, CopyBgTilemapBufferToVram uploads the whole tilemap buffer
+// every time. When disabled, only rows written through the functions in
+// this file are uploaded, so anything that writes the buffer directly must
+// call MarkBgTilemapBufferDirty.
+void SetBgTilemapBufferFullUploads(u8 bg, bool32 enabled)
+{
+    if (!IsInvalidBg32(bg))
+        sGpuBgConfigs2[bg].tilemapFullUploads = enabled;
+}
+
+void MarkBgTilemapBufferDirty(u8 bg)
+{
+    if (!IsInvalidBg32(bg))
+        sGpuBgConfigs2[bg].tilemapDirtyRows = TILEMAP_ALL_ROWS_DIRTY;
+}
+
 void UnsetBgTilemapBuffer(u8 bg)
 {
     if (!IsInvalidBg32(bg) && GetBgControlAttribute(bg, BG_CTRL_ATTR_VISIBLE))
@@ -867,8 +920,10 @@ void *GetBgTilemapBuffer(u8 bg)
         return NULL;
     else if (!GetBgControlAttribute(bg, BG_CTRL_ATTR_VISIBLE))
         return NULL;
-    else
-        return sGpuBgConfigs2[bg].tilemap;
+
+    // The caller is free to write to the buffer
+    sGpuBgConfigs2[bg].tilemapDirtyRows = TILEMAP_ALL_ROWS_DIRTY;
+    return sGpuBgConfigs2[bg].tilemap;
 }
 
 void CopyToBgTilemapBuffer(u8 bg, const void *src, u16 mode, u16 destOffset)
@@ -876,31 +931,127 @@ void CopyToBgTilemapBuffer(u8 bg, const void *src, u16 mode, u16 destOffset)
     if (!IsInvalidBg32(bg) && !IsTileMapOutsideWram(bg))
     {
         if (mode != 0)
+        {
             CpuCopy16(src, (void *)(sGpuBgConfigs2[bg].tilemap + (destOffset * 2)), mode);
+            MarkTilemapBufferRangeDirty(bg, destOffset * 2, mode);
+        }
         else
+        {
             LZ77UnCompWram(src, (void *)(sGpuBgConfigs2[bg].tilemap + (destOffset * 2)));
+            // Compressed tilemaps are almost always whole screens
+            MarkTilemapBufferRangeDirty(bg, destOffset * 2, GetBgTilemapBufferSize(bg));
+        }
+    }
+}
+
+static u16 GetBgTilemapBufferSize(u8 bg)
+{
+    switch (GetBgType(bg))
+    {
+    case BG_TYPE_NORMAL:
+        return GetBgMetricTextMode(bg, 0) * 0x800;
+    case BG_TYPE_AFFINE:
+        return GetBgMetricAffineMode(bg, 0) * 0x100;
+    default:
+        return 0;
+    }
+}
+
+static u32 GetTilemapDirtyRowShift(u16 bufferSize)
+{
+    u32 shift = 0;
+
+    while ((bufferSize >> shift) > TILEMAP_DIRTY_ROWS)
+        shift++;
+
+    return shift;
+}
+
+static void MarkTilemapBufferRangeDirty(u8 bg, u32 offset, u32 size)
+{
+    u32 shift, first, last;
+
+    if (size == 0)
+        return;
+
+    shift = GetTilemapDirtyRowShift(GetBgTilemapBufferSize(bg));
+    first = offset >> shift;
+    last = (offset + size - 1) >> shift;
+    if (first >= TILEMAP_DIRTY_ROWS)
+        return;
+    if (last >= TILEMAP_DIRTY_ROWS)
+        last = TILEMAP_DIRTY_ROWS - 1;
+
+    sGpuBgConfigs2[bg].tilemapDirtyRows |= ((2u << (last - first)) - 1) << first;
+}
+
+// For rects addressed with GetTileMapIndexFromCoords. The index grows with both
+// x and y, so the top left and bottom right corners bound everything in between.
+static void MarkTilemapBufferRectDirty(u8 bg, u32 x, u32 y, u32 width, u32 height)
+{
+    u32 screenSize, screenWidth, screenHeight;
+    u32 first, last;
+
+    if (width == 0 || height == 0)
+        return;
+
+    switch (GetBgType(bg))
+    {
+    case BG_TYPE_NORMAL:
+        screenSize = GetBgControlAttribute(bg, BG_CTRL_ATTR_SCREENSIZE);
+        screenWidth = GetBgMetricTextMode(bg, 0x1) * 0x20;
+        screenHeight = GetBgMetricTextMode(bg, 0x2) * 0x20;
+        if (x + width > screenWidth || y + height > screenHeight)
+        {
+            // Wraps around the edge of the map
+            sGpuBgConfigs2[bg].tilemapDirtyRows = TILEMAP_ALL_ROWS_DIRTY;
+            return;
+        }
+        first = GetTileMapIndexFromCoords(x, y, screenSize, screenWidth, screenHeight);
+        last = GetTileMapIndexFromCoords(x + width - 1, y + height - 1, screenSize, screenWidth, screenHeight);
+        MarkTilemapBufferRangeDirty(bg, first * 2, (last - first + 1) * 2);
+        break;
+    case BG_TYPE_AFFINE:
+        screenWidth = GetBgMetricAffineMode(bg, 0x1);
+        first = y * screenWidth + x;
+        last = (y + height - 1) * screenWidth + x + width - 1;
+        MarkTilemapBufferRangeDirty(bg, first, last - first + 1);
+        break;
     }
 }
 
 void CopyBgTilemapBufferToVram(u8 bg)
 {
     u16 sizeToLoad;
+    u32 dirtyRows, shift, start, end;
 
     if (!IsInvalidBg32(bg) && !IsTileMapOutsideWram(bg))
     {
-        switch (GetBgType(bg))
+        sizeToLoad = GetBgTilemapBufferSize(bg);
+        dirtyRows = sGpuBgConfigs2[bg].tilemapDirtyRows;
+        if (sGpuBgConfigs2[bg].tilemapFullUploads || dirtyRows == TILEMAP_ALL_ROWS_DIRTY || sizeToLoad == 0)
         {
-        case BG_TYPE_NORMAL:
-            sizeToLoad = GetBgMetricTextMode(bg, 0) * 0x800;
-            break;
-        case BG_TYPE_AFFINE:
-            sizeToLoad = GetBgMetricAffineMode(bg, 0) * 0x100;
-            break;
-        default:
-            sizeToLoad = 0;
-            break;
+            if (LoadBgVram(bg, sGpuBgConfigs2[bg].tilemap, sizeToLoad, 0, 2) != 0xFF)
+                sGpuBgConfigs2[bg].tilemapDirtyRows = 0;
+            return;
+        }
+
+        // Upload each run of dirty rows. Rows whose request doesn't fit in the
+        // DMA queue stay dirty for the next call.
+        shift = GetTilemapDirtyRowShift(sizeToLoad);
+        for (start = 0; dirtyRows != 0; start = end)
+        {
+            while (!(dirtyRows & 1))
+            {
+                dirtyRows >>= 1;
+                start++;
+            }
+            for (end = start; dirtyRows & 1; end++)
+                dirtyRows >>= 1;
+
+            if (LoadBgVram(bg, sGpuBgConfigs2[bg].tilemap + (start << shift), (end - start) << shift, start << shift, 2) != 0xFF)
+                sGpuBgConfigs2[bg].tilemapDirtyRows &= ~(((2u << (end - start - 1)) - 1) << start);
         }
-        LoadBgVram(bg, sGpuBgConfigs2[bg].tilemap, sizeToLoad, 0, 2);
     }
 }
 
@@ -924,6 +1075,8 @@ void CopyToBgTilemapBufferRect(u8 bg, const void *src, u8 destX, u8 destY, u8 wi
                     ((u16 *)sGpuBgConfigs2[bg].tilemap)[((destY16 * 0x20) + destX16)] = *srcCopy++;
                 }
             }
+            if (width != 0 && height != 0)
+                MarkTilemapBufferRangeDirty(bg, ((destY * 0x20) + destX) * 2, (((height - 1) * 0x20) + width) * 2);
             break;
         }
         case BG_TYPE_AFFINE:
@@ -937,6 +1090,8 @@ void CopyToBgTilemapBufferRect(u8 bg, const void *src, u8 destX, u8 destY, u8 wi
                     ((u8 *)sGpuBgConfigs2[bg].tilemap)[((destY16 * mode) + destX16)] = *srcCopy++;
                 }
             }
+            if (width != 0 && height != 0)
+                MarkTilemapBufferRangeDirty(bg, (destY * mode) + destX, ((height - 1) * mode) + width);
             break;
         }
         }
@@ -989,6 +1144,7 @@ void CopyRectToBgTilemapBufferRect(u8 bg, const void *src, u8 srcX, u8 srcY, u8
             }
             break;
         }
+        MarkTilemapBufferRectDirty(bg, destX, destY, rectWidth, rectHeight);
     }
 }
 
@@ -1010,6 +1166,8 @@ void FillBgTilemapBufferRect_Palette0(u8 bg, u16 tileNum, u8 x, u8 y, u8 width,
                     ((u16 *)sGpuBgConfigs2[bg].tilemap)[((y16 * 0x20) + x16)] = tileNum;
                 }
             }
+            if (width != 0 && height != 0)
+                MarkTilemapBufferRangeDirty(bg, ((y * 0x20) + x) * 2, (((height - 1) * 0x20) + width) * 2);
             break;
         case BG_TYPE_AFFINE:
             mode = GetBgMetricAffineMode(bg, 0x1);
@@ -1020,6 +1178,8 @@ void FillBgTilemapBufferRect_Palette0(u8 bg, u16 tileNum, u8 x, u8 y, u8 width,
                     ((u8 *)sGpuBgConfigs2[bg].tilemap)[((y16 * mode) + x16)] = tileNum;
                 }
             }
+            if (width != 0 && height != 0)
+                MarkTilemapBufferRangeDirty(bg, (y * mode) + x, ((height - 1) * mode) + width);
             break;
         }
     }
@@ -1067,6 +1227,7 @@ void WriteSequenceToBgTilemapBuffer(u8 bg, u16 firstTileNum, u8 x, u8 y, u8 widt
             }
             break;
         }
+        MarkTilemapBufferRectDirty(bg, x, y, width, height);
     }
 }
 
@@ -205,8 +205,3 @@ static void DecompressGlyph_Braille(u16 glyph)
     gCurGlyph.width = 16;
     gCurGlyph.height = 16;
 }
-
-u32 GetGlyphWidth_Braille(u16 glyphId, bool32 isJapanese)
-{
-    return 16;
-}
@@ -4077,6 +4077,7 @@ static void UpdateBlendTaskContestantData(u8 contestant)
                      &gPlttBufferUnfaded[palOffset2],
                      &gPlttBufferFaded[palOffset2],
                      PLTT_SIZEOF(1));
+    MarkPlttBufferDirty(PLTT_ID(contestant + 5), PLTT_SIZE_4BPP);
 }
 
 // See comments on CreateUnusedBlendTask
@@ -4144,15 +4145,17 @@ static u8 CreateContestantBoxBlinkSprites(u8 contestant)
     CpuFill32(0, gContestResources->boxBlinkTiles1 + 0x500, 0x300);
     CpuFill32(0, gContestResources->boxBlinkTiles2 + 0x500, 0x300);
 
-    RequestDma3Copy(gContestResources->boxBlinkTiles1,
-                    (u8 *)(OBJ_VRAM0 + gSprites[spriteId1].oam.tileNum * 32),
-                    0x800,
-                    1);
-
-    RequestDma3Copy(gContestResources->boxBlinkTiles2,
-                    (u8 *)(OBJ_VRAM0 + gSprites[spriteId2].oam.tileNum * 32),
-                    0x800,
-                    1);
+    RequestDma3CopyWithPriority(gContestResources->boxBlinkTiles1,
+                                (u8 *)(OBJ_VRAM0 + gSprites[spriteId1].oam.tileNum * 32),
+                                0x800,
+                                1,
+                                DMA3_PRIORITY_HIGH);
+
+    RequestDma3CopyWithPriority(gContestResources->boxBlinkTiles2,
+                                (u8 *)(OBJ_VRAM0 + gSprites[spriteId2].oam.tileNum * 32),
+                                0x800,
+                                1,
+                                DMA3_PRIORITY_HIGH);
 
     gSprites[spriteId1].data[0] = spriteId2;
     gSprites[spriteId2].data[0] = spriteId1;
@@ -2,25 +2,47 @@
 #include "dma3.h"
 
 #define MAX_DMA_REQUESTS 128
+#define DMA_REQUEST_NONE 0xFF
+
+// Queue links hold a request index plus one, so zeroed memory is a set of empty queues.
+#define DMA_QUEUE_END 0
+#define DMA_QUEUE_LINK(index) ((index) + 1)
+#define DMA_QUEUE_INDEX(link) ((link) - 1)
 
 #define DMA_REQUEST_COPY32 1
 #define DMA_REQUEST_FILL32 2
 #define DMA_REQUEST_COPY16 3
 #define DMA_REQUEST_FILL16 4
 
+#define IS_FILL_REQUEST(mode) ((mode) == DMA_REQUEST_FILL32 || (mode) == DMA_REQUEST_FILL16)
+
+// Requests are only started while VCOUNT is at most this, so they finish before the
+// display starts drawing again at scanline 228.
+#define DMA3_LAST_SCANLINE 224
+
+// A scanline lasts 1232 cycles. A DMA from EWRAM to VRAM costs 4 cycles per halfword
+// or 8 cycles per word, so either way about 616 bytes land per scanline. A whole
+// VBlank (scanlines 160-224) is 40040 bytes.
+#define DMA3_BYTES_PER_SCANLINE 616
+#define DMA3_BYTES_PER_VBLANK ((DMA3_LAST_SCANLINE + 1 - DISPLAY_HEIGHT) * DMA3_BYTES_PER_SCANLINE)
+
 struct Dma3Request
 {
     const u8 *src;
     u8 *dest;
     u16 size;
-    u16 mode;
+    u8 mode;
+    u8 priority;
     u32 value;
 };
 
 static struct Dma3Request sDma3Requests[MAX_DMA_REQUESTS];
+static u8 sDma3QueueNext[MAX_DMA_REQUESTS]; // link to the next request in the same priority queue
+static u8 sDma3QueueHeads[DMA3_PRIORITY_COUNT];
+static u8 sDma3QueueTails[DMA3_PRIORITY_COUNT];
 
 static vbool8 sDma3ManagerLocked;
-static u8 sDma3RequestCursor;
+static u8 sDma3RequestCursor; // where to start looking for a free request
 
 void ClearDma3Requests(void)
 {
@@ -34,132 +56,249 @@ void ClearDma3Requests(void)
         sDma3Requests[i].size = 0;
         sDma3Requests[i].src = NULL;
         sDma3Requests[i].dest = NULL;
+        sDma3QueueNext[i] = DMA_QUEUE_END;
+    }
+
+    for (i = 0; i < DMA3_PRIORITY_COUNT; i++)
+    {
+        sDma3QueueHeads[i] = DMA_QUEUE_END;
+        sDma3QueueTails[i] = DMA_QUEUE_END;
     }
 
     sDma3ManagerLocked = FALSE;
 }
 
+// How many bytes can still be transferred before VBlank ends.
+static u32 GetDma3VBlankBudget(u8 vcount)
+{
+    if (vcount < DISPLAY_HEIGHT)
+        return DMA3_BYTES_PER_VBLANK; // running late, behave as if VBlank just started
+    return (DMA3_LAST_SCANLINE + 1 - vcount) * DMA3_BYTES_PER_SCANLINE;
+}
+
 void ProcessDma3Requests(void)
 {
-    u16 bytesTransferred;
+    u32 bytesTransferred;
+    u32 budget;
+    s32 priority;
 
     if (sDma3ManagerLocked)
         return;
 
+    if (*(u8 *)REG_ADDR_VCOUNT > DMA3_LAST_SCANLINE)
+        return;
+
     bytesTransferred = 0;
+    budget = GetDma3VBlankBudget(*(u8 *)REG_ADDR_VCOUNT);
 
-    // as long as there are DMA requests to process (unless size or vblank is an issue), do not exit
-    while (sDma3Requests[sDma3RequestCursor].size != 0)
+    for (priority = DMA3_PRIORITY_COUNT - 1; priority >= 0; priority--)
     {
-        bytesTransferred += sDma3Requests[sDma3RequestCursor].size;
+        while (sDma3QueueHeads[priority] != DMA_QUEUE_END)
+        {
+            u8 index = DMA_QUEUE_INDEX(sDma3QueueHeads[priority]);
+            struct Dma3Request *request = &sDma3Requests[index];
 
-        if (bytesTransferred > 40 * 1024)
-            return; // don't transfer more than 40 KiB
-        if (*(u8 *)REG_ADDR_VCOUNT > 224)
-            return; // we're about to leave vblank, stop
+            // Always start at least one request so ones larger than the budget still get through.
+            if (bytesTransferred != 0 && bytesTransferred + request->size > budget)
+                return;
+            if (*(u8 *)REG_ADDR_VCOUNT > DMA3_LAST_SCANLINE)
+                return; // we're about to leave vblank, stop
 
-        switch (sDma3Requests[sDma3RequestCursor].mode)
-        {
-        case DMA_REQUEST_COPY32: // regular 32-bit copy
-            Dma3CopyLarge32_(sDma3Requests[sDma3RequestCursor].src,
-                             sDma3Requests[sDma3RequestCursor].dest,
-                             sDma3Requests[sDma3RequestCursor].size);
-            break;
-        case DMA_REQUEST_FILL32: // repeat a single 32-bit value across RAM
-            Dma3FillLarge32_(sDma3Requests[sDma3RequestCursor].value,
-                             sDma3Requests[sDma3RequestCursor].dest,
-                             sDma3Requests[sDma3RequestCursor].size);
-            break;
-        case DMA_REQUEST_COPY16:    // regular 16-bit copy
-            Dma3CopyLarge16_(sDma3Requests[sDma3RequestCursor].src,
-                             sDma3Requests[sDma3RequestCursor].dest,
-                             sDma3Requests[sDma3RequestCursor].size);
-            break;
-        case DMA_REQUEST_FILL16: // repeat a single 16-bit value across RAM
-            Dma3FillLarge16_(sDma3Requests[sDma3RequestCursor].value,
-                             sDma3Requests[sDma3RequestCursor].dest,
-                             sDma3Requests[sDma3RequestCursor].size);
-            break;
-        }
+            bytesTransferred += request->size;
 
-        // Free the request
-        sDma3Requests[sDma3RequestCursor].src = NULL;
-        sDma3Requests[sDma3RequestCursor].dest = NULL;
-        sDma3Requests[sDma3RequestCursor].size = 0;
-        sDma3Requests[sDma3RequestCursor].mode = 0;
-        sDma3Requests[sDma3RequestCursor].value = 0;
-        sDma3RequestCursor++;
+            switch (request->mode)
+            {
+            case DMA_REQUEST_COPY32: // regular 32-bit copy
+                Dma3CopyLarge32_(request->src, request->dest, request->size);
+                break;
+            case DMA_REQUEST_FILL32: // repeat a single 32-bit value across RAM
+                Dma3FillLarge32_(request->value, request->dest, request->size);
+                break;
+            case DMA_REQUEST_COPY16: // regular 16-bit copy
+                Dma3CopyLarge16_(request->src, request->dest, request->size);
+                break;
+            case DMA_REQUEST_FILL16: // repeat a single 16-bit value across RAM
+                Dma3FillLarge16_(request->value, request->dest, request->size);
+                break;
+            }
 
-        if (sDma3RequestCursor >= MAX_DMA_REQUESTS) // loop back to the first DMA request
-            sDma3RequestCursor = 0;
+            // Free the request
+            sDma3QueueHeads[priority] = sDma3QueueNext[index];
+            if (sDma3QueueHeads[priority] == DMA_QUEUE_END)
+                sDma3QueueTails[priority] = DMA_QUEUE_END;
+            request->src = NULL;
+            request->dest = NULL;
+            request->size = 0;
+            request->mode = 0;
+            request->value = 0;
+            sDma3QueueNext[index] = DMA_QUEUE_END;
+        }
     }
 }
 
-s16 RequestDma3Copy(const void *src, void *dest, u16 size, u8 mode)
+static bool32 RangesOverlap(const u8 *a, u32 aSize, const u8 *b, u32 bSize)
 {
+    return a < b + bSize && b < a + aSize;
+}
+
+// Whether running the new request before the queued one could change what either of them writes.
+static bool32 Dma3RequestsConflict(const struct Dma3Request *queued, const struct Dma3Request *new)
+{
+    if (RangesOverlap(queued->dest, queued->size, new->dest, new->size))
+        return TRUE;
+    if (!IS_FILL_REQUEST(queued->mode) && RangesOverlap(queued->src, queued->size, new->dest, new->size))
+        return TRUE;
+    if (!IS_FILL_REQUEST(new->mode) && RangesOverlap(queued->dest, queued->size, new->src, new->size))
+        return TRUE;
+    return FALSE;
+}
+
+// Whether the new request can be appended to the queued one as a single transfer.
+// Merged transfers stay within one VBlank's budget, so merging never makes a
+// transfer run into the display period that wouldn't have otherwise.
+static bool32 CanExtendDma3Request(const struct Dma3Request *queued, const struct Dma3Request *new)
+{
+    if (queued->mode != new->mode || queued->priority != new->priority)
+        return FALSE;
+    if (queued->dest + queued->size != new->dest || queued->size + new->size > DMA3_BYTES_PER_VBLANK)
+        return FALSE;
+    if (IS_FILL_REQUEST(new->mode))
+        return queued->value == new->value;
+    return queued->src + queued->size == new->src;
+}
+
+// Whether the new request writes exactly what the queued one does, making the queued one pointless.
+static bool32 CanReplaceDma3Request(const struct Dma3Request *queued, const struct Dma3Request *new)
+{
+    if (queued->dest != new->dest || queued->size != new->size)
+        return FALSE;
+    return IS_FILL_REQUEST(new->mode) || !RangesOverlap(queued->dest, queued->size, new->src, new->size);
+}
+
+static s16 AddDma3Request(const struct Dma3Request *new)
+{
+    int i;
     int cursor;
-    int i = 0;
+    int numConflicts = 0;
+    int conflict = DMA_REQUEST_NONE;
+    int extendable = DMA_REQUEST_NONE;
+    u8 priority = new->priority;
+    u8 link;
 
     sDma3ManagerLocked = TRUE;
-    cursor = sDma3RequestCursor;
 
-    while (i < MAX_DMA_REQUESTS)
+    // A request may not overtake an earlier one it overlaps, so it
+    // is queued no higher than the lowest of those it conflicts with.
+    for (i = 0; i < DMA3_PRIORITY_COUNT && new->size != 0; i++)
     {
-        if (sDma3Requests[cursor].size == 0) // an empty request was found.
+        for (link = sDma3QueueHeads[i]; link != DMA_QUEUE_END; link = sDma3QueueNext[DMA_QUEUE_INDEX(link)])
         {
-            sDma3Requests[cursor].src = src;
-            sDma3Requests[cursor].dest = dest;
-            sDma3Requests[cursor].size = size;
+            const struct Dma3Request *queued = &sDma3Requests[DMA_QUEUE_INDEX(link)];
 
-            if (mode == 1)
-                sDma3Requests[cursor].mode = DMA_REQUEST_COPY32;
-            else
-                sDma3Requests[cursor].mode = DMA_REQUEST_COPY16;
-
-            sDma3ManagerLocked = FALSE;
-            return cursor;
+            if (Dma3RequestsConflict(queued, new))
+            {
+                numConflicts++;
+                conflict = DMA_QUEUE_INDEX(link);
+                if (queued->priority < priority)
+                    priority = queued->priority;
+            }
+            else if (CanExtendDma3Request(queued, new))
+            {
+                extendable = DMA_QUEUE_INDEX(link);
+            }
         }
-        if (++cursor >= MAX_DMA_REQUESTS) // loop back to start.
-            cursor = 0;
-        i++;
     }
-    sDma3ManagerLocked = FALSE;
-    return -1;  // no free DMA request was found
-}
 
-s16 RequestDma3Fill(s32 value, void *dest, u16 size, u8 mode)
-{
-    int cursor;
-    int i = 0;
+    // Coalesce with a queued request when that doesn't reorder anything. The caller
+    // gets the index of the merged request, which is freed once both have landed.
+    if (numConflicts == 1 && CanReplaceDma3Request(&sDma3Requests[conflict], new))
+    {
+        sDma3Requests[conflict].src = new->src;
+        sDma3Requests[conflict].mode = new->mode;
+        sDma3Requests[conflict].value = new->value;
+        sDma3ManagerLocked = FALSE;
+        return conflict;
+    }
+    if (numConflicts == 0 && extendable != DMA_REQUEST_NONE)
+    {
+        sDma3Requests[extendable].size += new->size;
+        sDma3ManagerLocked = FALSE;
+        return extendable;
+    }
 
     cursor = sDma3RequestCursor;
-    sDma3ManagerLocked = TRUE;
-
-    while (i < MAX_DMA_REQUESTS)
+    for (i = 0; i < MAX_DMA_REQUESTS; i++)
     {
         if (sDma3Requests[cursor].size == 0) // an empty request was found.
         {
-            sDma3Requests[cursor].dest = dest;
-            sDma3Requests[cursor].size = size;
-            sDma3Requests[cursor].mode = mode;
-            sDma3Requests[cursor].value = value;
-
-            if(mode == 1)
-                sDma3Requests[cursor].mode = DMA_REQUEST_FILL32;
-            else
-                sDma3Requests[cursor].mode = DMA_REQUEST_FILL16;
+            // An empty transfer has nothing to queue, its request is simply already free.
+            if (new->size != 0)
+            {
+                sDma3Requests[cursor] = *new;
+                sDma3Requests[cursor].priority = priority;
+                sDma3QueueNext[cursor] = DMA_QUEUE_END;
 
+                if (sDma3QueueTails[priority] == DMA_QUEUE_END)
+                    sDma3QueueHeads[priority] = DMA_QUEUE_LINK(cursor);
+                else
+                    sDma3QueueNext[DMA_QUEUE_INDEX(sDma3QueueTails[priority])] = DMA_QUEUE_LINK(cursor);
+                sDma3QueueTails[priority] = DMA_QUEUE_LINK(cursor);
+                sDma3RequestCursor = (cursor + 1) % MAX_DMA_REQUESTS;
+            }
             sDma3ManagerLocked = FALSE;
             return cursor;
         }
         if (++cursor >= MAX_DMA_REQUESTS) // loop back to start.
             cursor = 0;
-        i++;
     }
     sDma3ManagerLocked = FALSE;
     return -1;  // no free DMA request was found
 }
 
+s16 RequestDma3CopyWithPriority(const void *src, void *dest, u16 size, u8 mode, u8 priority)
+{
+    struct Dma3Request request = {0};
+
+    request.src = src;
+    request.dest = dest;
+    request.size = size;
+    request.priority = priority;
+
+    if (mode == 1)
+        request.mode = DMA_REQUEST_COPY32;
+    else
+        request.mode = DMA_REQUEST_COPY16;
+
+    return AddDma3Request(&request);
+}
+
+s16 RequestDma3FillWithPriority(s32 value, void *dest, u16 size, u8 mode, u8 priority)
+{
+    struct Dma3Request request = {0};
+
+    request.dest = dest;
+    request.size = size;
+    request.value = value;
+    request.priority = priority;
+
+    if (mode == 1)
+        request.mode = DMA_REQUEST_FILL32;
+    else
+        request.mode = DMA_REQUEST_FILL16;
+
+    return AddDma3Request(&request);
+}
+
+s16 RequestDma3Copy(const void *src, void *dest, u16 size, u8 mode)
+{
+    return RequestDma3CopyWithPriority(src, dest, size, mode, DMA3_PRIORITY_NORMAL);
+}
+
+s16 RequestDma3Fill(s32 value, void *dest, u16 size, u8 mode)
+{
+    return RequestDma3FillWithPriority(value, dest, size, mode, DMA3_PRIORITY_NORMAL);
+}
+
 s16 CheckForSpaceForDma3Request(s16 index)
 {
     int i = 0;
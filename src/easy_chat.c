@@ -36,6 +36,7 @@
 static EWRAM_DATA struct EasyChatScreen *sEasyChatScreen = NULL;
 static EWRAM_DATA struct EasyChatScreenControl *sScreenControl = NULL;
 static EWRAM_DATA struct EasyChatScreenWordData *sWordData = NULL;
+static EWRAM_DATA struct Arena sEasyChatArena = {0};
 
 static void Task_InitEasyChatScreen(u8);
 static void CB2_EasyChatScreen(void);
@@ -45,7 +46,6 @@ static void ExitEasyChatScreen(MainCallback);
 static bool32 IsFuncIdForQuizLadyScreen(u16);
 static void EnterQuizLadyScreen(u16);
 static bool8 InitEasyChatScreenStruct(u8, u16 *, u8);
-static void FreeEasyChatScreenStruct(void);
 static u16 HandleEasyChatInput(void);
 static u16 HandleEasyChatInput_Phrase(void);
 static u16 HandleEasyChatInput_MainScreenButtons(void);
@@ -66,11 +66,9 @@ static void GetQuizTitle(u8 *);
 static void ClearUnusedField(void);
 static bool8 InitEasyChatScreenControl(void);
 static bool8 LoadEasyChatScreen(void);
-static void FreeEasyChatScreenControl(void);
 static void StartEasyChatFunction(u16);
 static bool8 RunEasyChatFunction(void);
 static bool8 InitEasyChatScreenWordData(void);
-static void FreeEasyChatScreenWordData(void);
 static u8 GetNumUnlockedEasyChatGroups(void);
 static int FooterHasFourOptions(void);
 static int DoDeleteAllButton(void);
@@ -1446,9 +1444,10 @@ static bool8 InitEasyChatScreen(u8 taskId)
 
 static void ExitEasyChatScreen(MainCallback callback)
 {
-    FreeEasyChatScreenControl();
-    FreeEasyChatScreenStruct();
-    FreeEasyChatScreenWordData();
+    sScreenControl = NULL;
+    sEasyChatScreen = NULL;
+    sWordData = NULL;
+    ArenaReset(&sEasyChatArena);
     FreeAllWindowBuffers();
     SetMainCallback2(callback);
 }
@@ -1639,7 +1638,7 @@ static bool8 InitEasyChatScreenStruct(u8 type, u16 *words, u8 displayedPersonTyp
     u8 templateId;
     int i;
 
-    sEasyChatScreen = Alloc(sizeof(*sEasyChatScreen));
+    sEasyChatScreen = ArenaAlloc(&sEasyChatArena, sizeof(*sEasyChatScreen));
     if (sEasyChatScreen == NULL)
         return FALSE;
 
@@ -1688,11 +1687,6 @@ static bool8 InitEasyChatScreenStruct(u8 type, u16 *words, u8 displayedPersonTyp
     return TRUE;
 }
 
-static void FreeEasyChatScreenStruct(void)
-{
-    TRY_FREE_AND_SET_NULL(sEasyChatScreen);
-}
-
 // Returns the function ID of the action to take as a result of player's input.
 // If no action is needed, returns ECFUNC_NONE
 static u16 HandleEasyChatInput(void)
@@ -3090,11 +3084,6 @@ static bool8 LoadEasyChatScreen(void)
     return TRUE;
 }
 
-static void FreeEasyChatScreenControl(void)
-{
-    TRY_FREE_AND_SET_NULL(sScreenControl);
-}
-
 static void StartEasyChatFunction(u16 funcId)
 {
     sScreenControl->currentFuncId = funcId;
@@ -3894,7 +3883,7 @@ static bool8 ShowCantExitMsg(void)
 
 static bool8 InitEasyChatScreenControl_(void)
 {
-    sScreenControl = Alloc(sizeof(*sScreenControl));
+    sScreenControl = ArenaAlloc(&sEasyChatArena, sizeof(*sScreenControl));
     if (!sScreenControl)
         return FALSE;
 
@@ -5596,7 +5585,10 @@ void InitEasyChatPhrases(void)
 
 static bool8 InitEasyChatScreenWordData(void)
 {
-    sWordData = Alloc(sizeof(*sWordData));
+    // The word data is loaded first, so start the arena that the screen's
+    // other structs are allocated from as well.
+    ArenaBegin(&sEasyChatArena, sizeof(*sWordData) + sizeof(*sEasyChatScreen) + sizeof(*sScreenControl));
+    sWordData = ArenaAlloc(&sEasyChatArena, sizeof(*sWordData));
     if (!sWordData)
         return FALSE;
 
@@ -5605,11 +5597,6 @@ static bool8 InitEasyChatScreenWordData(void)
     return TRUE;
 }
 
-static void FreeEasyChatScreenWordData(void)
-{
-    TRY_FREE_AND_SET_NULL(sWordData);
-}
-
 static void SetUnlockedEasyChatGroups(void)
 {
     int i;
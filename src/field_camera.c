@@ -30,6 +30,8 @@ static void RedrawMapSliceWest(struct FieldCameraOffset *, const struct MapLayou
 static s32 MapPosToBgTilemapOffset(struct FieldCameraOffset *, s32, s32);
 static void DrawWholeMapViewInternal(int, int, const struct MapLayout *);
 static void DrawMetatileAt(const struct MapLayout *, u16, int, int);
+static void DrawMetatileSlice(const struct MapLayout *, int, int, u32, u32, bool32);
+static void WriteMetatile(s32, const u16 *, u16);
 static void DrawMetatile(s32, const u16 *, u16);
 static void CameraPanningCB_PanAhead(void);
 
@@ -100,8 +102,6 @@ void DrawWholeMapView(void)
 static void DrawWholeMapViewInternal(int x, int y, const struct MapLayout *mapLayout)
 {
     u8 i;
-    u8 j;
-    u32 r6;
     u8 temp;
 
     for (i = 0; i < 32; i += 2)
@@ -109,14 +109,7 @@ static void DrawWholeMapViewInternal(int x, int y, const struct MapLayout *mapLa
         temp = sFieldCameraOffset.yTileOffset + i;
         if (temp >= 32)
             temp -= 32;
-        r6 = temp * 32;
-        for (j = 0; j < 32; j += 2)
-        {
-            temp = sFieldCameraOffset.xTileOffset + j;
-            if (temp >= 32)
-                temp -= 32;
-            DrawMetatileAt(mapLayout, r6 + temp, x + j / 2, y + i / 2);
-        }
+        DrawMetatileSlice(mapLayout, x, y + i / 2, sFieldCameraOffset.xTileOffset, temp, FALSE);
     }
 }
 
@@ -137,68 +130,30 @@ static void RedrawMapSlicesForCameraUpdate(struct FieldCameraOffset *cameraOffse
 
 static void RedrawMapSliceNorth(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
-    u8 temp;
-    u32 r7;
+    u8 temp = cameraOffset->yTileOffset + 28;
 
-    temp = cameraOffset->yTileOffset + 28;
     if (temp >= 32)
         temp -= 32;
-    r7 = temp * 32;
-    for (i = 0; i < 32; i += 2)
-    {
-        temp = cameraOffset->xTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, r7 + temp, gSaveBlock1Ptr->pos.x + i / 2, gSaveBlock1Ptr->pos.y + 14);
-    }
+    DrawMetatileSlice(mapLayout, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y + 14, cameraOffset->xTileOffset, temp, FALSE);
 }
 
 static void RedrawMapSliceSouth(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
-    u8 temp;
-    u32 r7 = cameraOffset->yTileOffset * 32;
-
-    for (i = 0; i < 32; i += 2)
-    {
-        temp = cameraOffset->xTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, r7 + temp, gSaveBlock1Ptr->pos.x + i / 2, gSaveBlock1Ptr->pos.y);
-    }
+    DrawMetatileSlice(mapLayout, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y, cameraOffset->xTileOffset, cameraOffset->yTileOffset, FALSE);
 }
 
 static void RedrawMapSliceEast(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
-    u8 temp;
-    u32 r6 = cameraOffset->xTileOffset;
-
-    for (i = 0; i < 32; i += 2)
-    {
-        temp = cameraOffset->yTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, temp * 32 + r6, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y + i / 2);
-    }
+    DrawMetatileSlice(mapLayout, gSaveBlock1Ptr->pos.x, gSaveBlock1Ptr->pos.y, cameraOffset->xTileOffset, cameraOffset->yTileOffset, TRUE);
 }
 
 static void RedrawMapSliceWest(struct FieldCameraOffset *cameraOffset, const struct MapLayout *mapLayout)
 {
-    u8 i;
-    u8 temp;
-    u8 r5 = cameraOffset->xTileOffset + 28;
+    u8 temp = cameraOffset->xTileOffset + 28;
 
-    if (r5 >= 32)
-        r5 -= 32;
-    for (i = 0; i < 32; i += 2)
-    {
-        temp = cameraOffset->yTileOffset + i;
-        if (temp >= 32)
-            temp -= 32;
-        DrawMetatileAt(mapLayout, temp * 32 + r5, gSaveBlock1Ptr->pos.x + 14, gSaveBlock1Ptr->pos.y + i / 2);
-    }
+    if (temp >= 32)
+        temp -= 32;
+    DrawMetatileSlice(mapLayout, gSaveBlock1Ptr->pos.x + 14, gSaveBlock1Ptr->pos.y, temp, cameraOffset->yTileOffset, TRUE);
 }
 
 void CurrentMapDrawMetatileAt(int x, int y)
@@ -223,87 +178,113 @@ void DrawDoorMetatileAt(int x, int y, u16 *tiles)
     }
 }
 
-static void DrawMetatileAt(const struct MapLayout *mapLayout, u16 offset, int x, int y)
+static const u16 *GetMetatileTiles(const struct MapLayout *mapLayout, u32 metatileId)
 {
-    u16 metatileId = MapGridGetMetatileIdAt(x, y);
-    const u16 *metatiles;
-
     if (metatileId > NUM_METATILES_TOTAL)
         metatileId = 0;
     if (metatileId < NUM_METATILES_IN_PRIMARY)
-    {
-        metatiles = mapLayout->primaryTileset->metatiles;
-    }
+        return mapLayout->primaryTileset->metatiles + metatileId * NUM_TILES_PER_METATILE;
     else
+        return mapLayout->secondaryTileset->metatiles + (metatileId - NUM_METATILES_IN_PRIMARY) * NUM_TILES_PER_METATILE;
+}
+
+static void DrawMetatileAt(const struct MapLayout *mapLayout, u16 offset, int x, int y)
+{
+    DrawMetatile(MapGridGetMetatileLayerTypeAt(x, y), GetMetatileTiles(mapLayout, MapGridGetMetatileIdAt(x, y)), offset);
+}
+
+// Draws the 16 metatiles of a row of the view (or a column, if vertical) starting
+// at map position (x, y), with the first one's top left tile at (tileX, tileY) in
+// the tilemaps. The metatile IDs are read all at once, and a run of the same
+// metatile only looks up its tiles and layer type once.
+static void DrawMetatileSlice(const struct MapLayout *mapLayout, int x, int y, u32 tileX, u32 tileY, bool32 vertical)
+{
+    u16 metatileIds[16];
+    const u16 *tiles = NULL;
+    u32 i, metatileId, prevMetatileId = 0xFFFF;
+    s32 metatileLayerType = 0;
+
+    MapGridGetMetatileIdsInLine(x, y, vertical, metatileIds, ARRAY_COUNT(metatileIds));
+    for (i = 0; i < ARRAY_COUNT(metatileIds); i++)
     {
-        metatiles = mapLayout->secondaryTileset->metatiles;
-        metatileId -= NUM_METATILES_IN_PRIMARY;
+        metatileId = metatileIds[i];
+        if (metatileId != prevMetatileId)
+        {
+            prevMetatileId = metatileId;
+            tiles = GetMetatileTiles(mapLayout, metatileId);
+            metatileLayerType = UNPACK_LAYER_TYPE(GetMetatileAttributesById(metatileId));
+        }
+        WriteMetatile(metatileLayerType, tiles, tileY * 32 + tileX);
+
+        if (vertical)
+            tileY = (tileY + 2) % 32;
+        else
+            tileX = (tileX + 2) % 32;
     }
-    DrawMetatile(MapGridGetMetatileLayerTypeAt(x, y), metatiles + metatileId * NUM_TILES_PER_METATILE, offset);
+    ScheduleBgCopyTilemapToVram(1);
+    ScheduleBgCopyTilemapToVram(2);
+    ScheduleBgCopyTilemapToVram(3);
 }
 
-static void DrawMetatile(s32 metatileLayerType, const u16 *tiles, u16 offset)
+// Metatiles always start on an even tile, so each half of a metatile is written
+// to the tilemaps as one word.
+static void WriteMetatile(s32 metatileLayerType, const u16 *tiles, u16 offset)
 {
+    u32 *bg1 = (u32 *)&gOverworldTilemapBuffer_Bg1[offset];
+    u32 *bg2 = (u32 *)&gOverworldTilemapBuffer_Bg2[offset];
+    u32 *bg3 = (u32 *)&gOverworldTilemapBuffer_Bg3[offset];
+    u32 bottomLayerTop = tiles[0] | ((u32)tiles[1] << 16);
+    u32 bottomLayerBottom = tiles[2] | ((u32)tiles[3] << 16);
+    u32 topLayerTop = tiles[4] | ((u32)tiles[5] << 16);
+    u32 topLayerBottom = tiles[6] | ((u32)tiles[7] << 16);
+
     switch (metatileLayerType)
     {
     case METATILE_LAYER_TYPE_SPLIT:
         // Draw metatile's bottom layer to the bottom background layer.
-        gOverworldTilemapBuffer_Bg3[offset] = tiles[0];
-        gOverworldTilemapBuffer_Bg3[offset + 1] = tiles[1];
-        gOverworldTilemapBuffer_Bg3[offset + 0x20] = tiles[2];
-        gOverworldTilemapBuffer_Bg3[offset + 0x21] = tiles[3];
+        bg3[0] = bottomLayerTop;
+        bg3[16] = bottomLayerBottom;
 
         // Draw transparent tiles to the middle background layer.
-        gOverworldTilemapBuffer_Bg2[offset] = 0;
-        gOverworldTilemapBuffer_Bg2[offset + 1] = 0;
-        gOverworldTilemapBuffer_Bg2[offset + 0x20] = 0;
-        gOverworldTilemapBuffer_Bg2[offset + 0x21] = 0;
+        bg2[0] = 0;
+        bg2[16] = 0;
 
         // Draw metatile's top layer to the top background layer.
-        gOverworldTilemapBuffer_Bg1[offset] = tiles[4];
-        gOverworldTilemapBuffer_Bg1[offset + 1] = tiles[5];
-        gOverworldTilemapBuffer_Bg1[offset + 0x20] = tiles[6];
-        gOverworldTilemapBuffer_Bg1[offset + 0x21] = tiles[7];
+        bg1[0] = topLayerTop;
+        bg1[16] = topLayerBottom;
         break;
     case METATILE_LAYER_TYPE_COVERED:
         // Draw metatile's bottom layer to the bottom background layer.
-        gOverworldTilemapBuffer_Bg3[offset] = tiles[0];
-        gOverworldTilemapBuffer_Bg3[offset + 1] = tiles[1];
-        gOverworldTilemapBuffer_Bg3[offset + 0x20] = tiles[2];
-        gOverworldTilemapBuffer_Bg3[offset + 0x21] = tiles[3];
+        bg3[0] = bottomLayerTop;
+        bg3[16] = bottomLayerBottom;
 
         // Draw metatile's top layer to the middle background layer.
-        gOverworldTilemapBuffer_Bg2[offset] = tiles[4];
-        gOverworldTilemapBuffer_Bg2[offset + 1] = tiles[5];
-        gOverworldTilemapBuffer_Bg2[offset + 0x20] = tiles[6];
-        gOverworldTilemapBuffer_Bg2[offset + 0x21] = tiles[7];
+        bg2[0] = topLayerTop;
+        bg2[16] = topLayerBottom;
 
         // Draw transparent tiles to the top background layer.
-        gOverworldTilemapBuffer_Bg1[offset] = 0;
-        gOverworldTilemapBuffer_Bg1[offset + 1] = 0;
-        gOverworldTilemapBuffer_Bg1[offset + 0x20] = 0;
-        gOverworldTilemapBuffer_Bg1[offset + 0x21] = 0;
+        bg1[0] = 0;
+        bg1[16] = 0;
         break;
     case METATILE_LAYER_TYPE_NORMAL:
         // Draw garbage to the bottom background layer.
-        gOverworldTilemapBuffer_Bg3[offset] = 0x3014;
-        gOverworldTilemapBuffer_Bg3[offset + 1] = 0x3014;
-        gOverworldTilemapBuffer_Bg3[offset + 0x20] = 0x3014;
-        gOverworldTilemapBuffer_Bg3[offset + 0x21] = 0x3014;
+        bg3[0] = 0x30143014;
+        bg3[16] = 0x30143014;
 
         // Draw metatile's bottom layer to the middle background layer.
-        gOverworldTilemapBuffer_Bg2[offset] = tiles[0];
-        gOverworldTilemapBuffer_Bg2[offset + 1] = tiles[1];
-        gOverworldTilemapBuffer_Bg2[offset + 0x20] = tiles[2];
-        gOverworldTilemapBuffer_Bg2[offset + 0x21] = tiles[3];
+        bg2[0] = bottomLayerTop;
+        bg2[16] = bottomLayerBottom;
 
         // Draw metatile's top layer to the top background layer, which covers object event sprites.
-        gOverworldTilemapBuffer_Bg1[offset] = tiles[4];
-        gOverworldTilemapBuffer_Bg1[offset + 1] = tiles[5];
-        gOverworldTilemapBuffer_Bg1[offset + 0x20] = tiles[6];
-        gOverworldTilemapBuffer_Bg1[offset + 0x21] = tiles[7];
+        bg1[0] = topLayerTop;
+        bg1[16] = topLayerBottom;
         break;
     }
+}
+
+static void DrawMetatile(s32 metatileLayerType, const u16 *tiles, u16 offset)
+{
+    WriteMetatile(metatileLayerType, tiles, offset);
     ScheduleBgCopyTilemapToVram(1);
     ScheduleBgCopyTilemapToVram(2);
     ScheduleBgCopyTilemapToVram(3);
@@ -857,12 +857,48 @@ static bool8 TryDoorWarp(struct MapPosition *position, u16 metatileBehavior, u8
     return FALSE;
 }
 
+// Binary searches a list of event indices sorted by position (see MapEvents) and
+// returns where the events at (x, y) start in it. Warp, coord and bg events all
+// begin with their x and y coordinates.
+static u32 FindEventsAtPosition(const u8 *eventsByPosition, const void *events, u32 eventSize, u32 eventCount, u16 x, u16 y)
+{
+    u32 lo = 0;
+    u32 hi = eventCount;
+    u32 key = ((u32)y << 16) | x;
+
+    while (lo < hi)
+    {
+        u32 mid = (lo + hi) / 2;
+        const u16 *position = (const u16 *)((const u8 *)events + eventsByPosition[mid] * eventSize);
+
+        if ((((u32)position[1] << 16) | position[0]) < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
 static s8 GetWarpEventAtPosition(struct MapHeader *mapHeader, u16 x, u16 y, u8 elevation)
 {
     s32 i;
     const struct WarpEvent *warpEvent = mapHeader->events->warps;
+    const u8 *warpsByPosition = mapHeader->events->warpsByPosition;
     u8 warpCount = mapHeader->events->warpCount;
 
+    if (warpsByPosition != NULL)
+    {
+        for (i = FindEventsAtPosition(warpsByPosition, warpEvent, sizeof(*warpEvent), warpCount, x, y); i < warpCount; i++)
+        {
+            warpEvent = &mapHeader->events->warps[warpsByPosition[i]];
+            if ((u16)warpEvent->x != x || (u16)warpEvent->y != y)
+                break;
+            if (warpEvent->elevation == elevation || warpEvent->elevation == ELEVATION_TRANSITION)
+                return warpsByPosition[i];
+        }
+        return WARP_ID_NONE;
+    }
+
     for (i = 0; i < warpCount; i++, warpEvent++)
     {
         if ((u16)warpEvent->x == x && (u16)warpEvent->y == y)
@@ -898,8 +934,26 @@ static const u8 *GetCoordEventScriptAtPosition(struct MapHeader *mapHeader, u16
 {
     s32 i;
     const struct CoordEvent *coordEvents = mapHeader->events->coordEvents;
+    const u8 *coordEventsByPosition = mapHeader->events->coordEventsByPosition;
     u8 coordEventCount = mapHeader->events->coordEventCount;
 
+    if (coordEventsByPosition != NULL)
+    {
+        for (i = FindEventsAtPosition(coordEventsByPosition, coordEvents, sizeof(*coordEvents), coordEventCount, x, y); i < coordEventCount; i++)
+        {
+            const struct CoordEvent *coordEvent = &coordEvents[coordEventsByPosition[i]];
+            if ((u16)coordEvent->x != x || (u16)coordEvent->y != y)
+                break;
+            if (coordEvent->elevation == elevation || coordEvent->elevation == ELEVATION_TRANSITION)
+            {
+                const u8 *script = TryRunCoordEventScript(coordEvent);
+                if (script != NULL)
+                    return script;
+            }
+        }
+        return NULL;
+    }
+
     for (i = 0; i < coordEventCount; i++)
     {
         if ((u16)coordEvents[i].x == x && (u16)coordEvents[i].y == y)
@@ -924,8 +978,22 @@ static const struct BgEvent *GetBackgroundEventAtPosition(struct MapHeader *mapH
 {
     u8 i;
     const struct BgEvent *bgEvents = mapHeader->events->bgEvents;
+    const u8 *bgEventsByPosition = mapHeader->events->bgEventsByPosition;
     u8 bgEventCount = mapHeader->events->bgEventCount;
 
+    if (bgEventsByPosition != NULL)
+    {
+        for (i = FindEventsAtPosition(bgEventsByPosition, bgEvents, sizeof(*bgEvents), bgEventCount, x, y); i < bgEventCount; i++)
+        {
+            const struct BgEvent *bgEvent = &bgEvents[bgEventsByPosition[i]];
+            if (bgEvent->x != x || bgEvent->y != y)
+                break;
+            if (bgEvent->elevation == elevation || bgEvent->elevation == ELEVATION_TRANSITION)
+                return bgEvent;
+        }
+        return NULL;
+    }
+
     for (i = 0; i < bgEventCount; i++)
     {
         if ((u16)bgEvents[i].x == x && (u16)bgEvents[i].y == y)
@@ -64,11 +64,13 @@ static const struct ScanlineEffectParams sFlashEffectParams =
 static void FillPalBufferWhite(void)
 {
     CpuFastFill16(RGB_WHITE, gPlttBufferFaded, PLTT_SIZE);
+    MarkPlttBufferDirty(0, PLTT_SIZE);
 }
 
 static void FillPalBufferBlack(void)
 {
     CpuFastFill16(RGB_BLACK, gPlttBufferFaded, PLTT_SIZE);
+    MarkPlttBufferDirty(0, PLTT_SIZE);
 }
 
 void WarpFadeInScreen(void)
@@ -652,6 +654,7 @@ static void Task_WarpAndLoadMap(u8 taskId)
     case 0:
         FreezeObjectEvents();
         LockPlayerFieldControls();
+        PrefetchMapTilesets(GetDestinationWarpMapHeader()->mapLayout);
         task->tState++;
         break;
     case 1:
@@ -33,6 +33,16 @@ struct RGBColor
     u16 b:5;
 };
 
+// A palette with a color map applied, kept so that it only has to be mapped
+// again when its colors or the color map change. This matters most during
+// fades, which blend every mapped palette toward a color on every frame.
+struct ColorMappedPalette
+{
+    const void *colorMap; // NULL if nothing has been mapped yet
+    u16 ALIGNED(4) unfaded[16];
+    u16 ALIGNED(4) mapped[16];
+};
+
 struct WeatherCallbacks
 {
     void (*initVars)(void);
@@ -47,7 +57,6 @@ static void BuildColorMaps(void);
 static void UpdateWeatherColorMap(void);
 static void ApplyColorMap(u8 startPalIndex, u8 numPalettes, s8 colorMapIndex);
 static void ApplyColorMapWithBlend(u8 startPalIndex, u8 numPalettes, s8 colorMapIndex, u8 blendCoeff, u16 blendColor);
-static void ApplyDroughtColorMapWithBlend(s8 colorMapIndex, u8 blendCoeff, u16 blendColor);
 static void ApplyFogBlend(u8 blendCoeff, u16 blendColor);
 static bool8 FadeInScreen_RainShowShade(void);
 static bool8 FadeInScreen_Drought(void);
@@ -62,6 +71,7 @@ static u8 None_Finish(void);
 
 EWRAM_DATA struct Weather gWeather = {0};
 EWRAM_DATA static u8 ALIGNED(2) sFieldEffectPaletteColorMapTypes[32] = {0};
+EWRAM_DATA static struct ColorMappedPalette sColorMappedPalettes[32] = {0};
 
 static const u8 *sPaletteColorMapTypes;
 
@@ -280,6 +290,9 @@ static void BuildColorMaps(void)
     s16 diff;
 
     sPaletteColorMapTypes = sBasePaletteColorMapTypes;
+    for (i = 0; i < ARRAY_COUNT(sColorMappedPalettes); i++)
+        sColorMappedPalettes[i].colorMap = NULL;
+
     for (i = 0; i < 2; i++)
     {
         if (i == 0)
@@ -439,7 +452,7 @@ static bool8 FadeInScreen_Drought(void)
         return FALSE;
     }
 
-    ApplyDroughtColorMapWithBlend(-6, 16 - gWeatherPtr->fadeScreenCounter, gWeatherPtr->fadeDestColor);
+    ApplyColorMapWithBlend(0, 32, -6, 16 - gWeatherPtr->fadeScreenCounter, gWeatherPtr->fadeDestColor);
     return TRUE;
 }
 
@@ -456,77 +469,93 @@ static bool8 FadeInScreen_FogHorizontal(void)
 static void DoNothing(void)
 { }
 
-static void ApplyColorMap(u8 startPalIndex, u8 numPalettes, s8 colorMapIndex)
+// Returns the palette with the color map applied. A positive colorMapIndex
+// picks one of the contrast color maps, a negative one the drought colors.
+static const u16 *GetColorMappedPalette(u16 palIndex, s8 colorMapIndex, bool8 useDarkenedMap)
 {
-    u16 curPalIndex;
-    u16 palOffset;
-    u8 *colorMap;
+    struct ColorMappedPalette *palette = &sColorMappedPalettes[palIndex];
+    const u16 *unfaded = &gPlttBufferUnfaded[PLTT_ID(palIndex)];
+    const void *colorMap;
     u16 i;
 
     if (colorMapIndex > 0)
     {
-        colorMapIndex--;
-        palOffset = PLTT_ID(startPalIndex);
-        numPalettes += startPalIndex;
-        curPalIndex = startPalIndex;
+        if (useDarkenedMap)
+            colorMap = gWeatherPtr->darkenedContrastColorMaps[colorMapIndex - 1];
+        else
+            colorMap = gWeatherPtr->contrastColorMaps[colorMapIndex - 1];
+    }
+    else
+    {
+        colorMap = sDroughtWeatherColors[-colorMapIndex - 1];
+    }
 
-        // Loop through the specified palette range and apply necessary color maps.
-        while (curPalIndex < numPalettes)
-        {
-            if (sPaletteColorMapTypes[curPalIndex] == COLOR_MAP_NONE)
-            {
-                // No palette change.
-                CpuFastCopy(&gPlttBufferUnfaded[palOffset], &gPlttBufferFaded[palOffset], PLTT_SIZE_4BPP);
-                palOffset += 16;
-            }
-            else
-            {
-                u8 r, g, b;
+    if (palette->colorMap == colorMap)
+    {
+        const u32 *cur = (const u32 *)unfaded;
+        const u32 *prev = (const u32 *)palette->unfaded;
 
-                if (sPaletteColorMapTypes[curPalIndex] == COLOR_MAP_CONTRAST || curPalIndex - 16 == gWeatherPtr->contrastColorMapSpritePalIndex)
-                    colorMap = gWeatherPtr->contrastColorMaps[colorMapIndex];
-                else
-                    colorMap = gWeatherPtr->darkenedContrastColorMaps[colorMapIndex];
+        for (i = 0; i < 16 / 2; i++)
+        {
+            if (cur[i] != prev[i])
+                break;
+        }
+        if (i == 16 / 2)
+            return palette->mapped;
+    }
 
-                for (i = 0; i < 16; i++)
-                {
-                    // Apply color map to the original color.
-                    struct RGBColor baseColor = *(struct RGBColor *)&gPlttBufferUnfaded[palOffset];
-                    r = colorMap[baseColor.r];
-                    g = colorMap[baseColor.g];
-                    b = colorMap[baseColor.b];
-                    gPlttBufferFaded[palOffset++] = RGB2(r, g, b);
-                }
-            }
+    if (colorMapIndex > 0)
+    {
+        const u8 *contrastColorMap = colorMap;
 
-            curPalIndex++;
+        for (i = 0; i < 16; i++)
+        {
+            struct RGBColor baseColor = *(const struct RGBColor *)&unfaded[i];
+            palette->mapped[i] = RGB2(contrastColorMap[baseColor.r], contrastColorMap[baseColor.g], contrastColorMap[baseColor.b]);
         }
     }
-    else if (colorMapIndex < 0)
+    else
+    {
+        const u16 *droughtColors = colorMap;
+
+        for (i = 0; i < 16; i++)
+            palette->mapped[i] = droughtColors[DROUGHT_COLOR_INDEX(unfaded[i])];
+    }
+
+    CpuFastCopy(unfaded, palette->unfaded, PLTT_SIZE_4BPP);
+    palette->colorMap = colorMap;
+    return palette->mapped;
+}
+
+static void ApplyColorMap(u8 startPalIndex, u8 numPalettes, s8 colorMapIndex)
+{
+    u16 curPalIndex;
+    u16 palOffset;
+
+    MarkPlttBufferDirty(PLTT_ID(startPalIndex), numPalettes * PLTT_SIZE_4BPP);
+    if (colorMapIndex != 0)
     {
-        // A negative gammIndex value means that the blending will come from the special Drought weather's palette tables.
-        colorMapIndex = -colorMapIndex - 1;
         palOffset = PLTT_ID(startPalIndex);
         numPalettes += startPalIndex;
         curPalIndex = startPalIndex;
 
+        // Loop through the specified palette range and apply necessary color maps.
         while (curPalIndex < numPalettes)
         {
             if (sPaletteColorMapTypes[curPalIndex] == COLOR_MAP_NONE)
             {
                 // No palette change.
                 CpuFastCopy(&gPlttBufferUnfaded[palOffset], &gPlttBufferFaded[palOffset], PLTT_SIZE_4BPP);
-                palOffset += 16;
             }
             else
             {
-                for (i = 0; i < 16; i++)
-                {
-                    gPlttBufferFaded[palOffset] = sDroughtWeatherColors[colorMapIndex][DROUGHT_COLOR_INDEX(gPlttBufferUnfaded[palOffset])];
-                    palOffset++;
-                }
+                bool8 useDarkenedMap = sPaletteColorMapTypes[curPalIndex] != COLOR_MAP_CONTRAST
+                                    && curPalIndex - 16 != gWeatherPtr->contrastColorMapSpritePalIndex;
+
+                CpuFastCopy(GetColorMappedPalette(curPalIndex, colorMapIndex, useDarkenedMap), &gPlttBufferFaded[palOffset], PLTT_SIZE_4BPP);
             }
 
+            palOffset += 16;
             curPalIndex++;
         }
     }
@@ -537,6 +566,8 @@ static void ApplyColorMap(u8 startPalIndex, u8 numPalettes, s8 colorMapIndex)
     }
 }
 
+// Blends the color mapped palettes toward blendColor. A negative colorMapIndex
+// uses the drought colors.
 static void ApplyColorMapWithBlend(u8 startPalIndex, u8 numPalettes, s8 colorMapIndex, u8 blendCoeff, u16 blendColor)
 {
     u16 palOffset;
@@ -547,9 +578,9 @@ static void ApplyColorMapWithBlend(u8 startPalIndex, u8 numPalettes, s8 colorMap
     u8 gBlend = color.g;
     u8 bBlend = color.b;
 
+    MarkPlttBufferDirty(PLTT_ID(startPalIndex), numPalettes * PLTT_SIZE_4BPP);
     palOffset = PLTT_ID(startPalIndex);
     numPalettes += startPalIndex;
-    colorMapIndex--;
     curPalIndex = startPalIndex;
 
     while (curPalIndex < numPalettes)
@@ -562,21 +593,16 @@ static void ApplyColorMapWithBlend(u8 startPalIndex, u8 numPalettes, s8 colorMap
         }
         else
         {
-            u8 *colorMap;
-
-            if (sPaletteColorMapTypes[curPalIndex] == COLOR_MAP_DARK_CONTRAST)
-                colorMap = gWeatherPtr->darkenedContrastColorMaps[colorMapIndex];
-            else
-                colorMap = gWeatherPtr->contrastColorMaps[colorMapIndex];
+            const u16 *mapped = GetColorMappedPalette(curPalIndex, colorMapIndex, sPaletteColorMapTypes[curPalIndex] == COLOR_MAP_DARK_CONTRAST);
 
             for (i = 0; i < 16; i++)
             {
-                struct RGBColor baseColor = *(struct RGBColor *)&gPlttBufferUnfaded[palOffset];
-                u8 r = colorMap[baseColor.r];
-                u8 g = colorMap[baseColor.g];
-                u8 b = colorMap[baseColor.b];
+                struct RGBColor baseColor = *(const struct RGBColor *)&mapped[i];
+                u8 r = baseColor.r;
+                u8 g = baseColor.g;
+                u8 b = baseColor.b;
 
-                // Apply color map and target blend color to the original color.
+                // Apply target blend color to the color mapped color.
                 r += ((rBlend - r) * blendCoeff) >> 4;
                 g += ((gBlend - g) * blendCoeff) >> 4;
                 b += ((bBlend - b) * blendCoeff) >> 4;
@@ -588,61 +614,6 @@ static void ApplyColorMapWithBlend(u8 startPalIndex, u8 numPalettes, s8 colorMap
     }
 }
 
-static void ApplyDroughtColorMapWithBlend(s8 colorMapIndex, u8 blendCoeff, u16 blendColor)
-{
-    struct RGBColor color;
-    u8 rBlend;
-    u8 gBlend;
-    u8 bBlend;
-    u16 curPalIndex;
-    u16 palOffset;
-    u16 i;
-
-    colorMapIndex = -colorMapIndex - 1;
-    color = *(struct RGBColor *)&blendColor;
-    rBlend = color.r;
-    gBlend = color.g;
-    bBlend = color.b;
-    palOffset = 0;
-    for (curPalIndex = 0; curPalIndex < 32; curPalIndex++)
-    {
-        if (sPaletteColorMapTypes[curPalIndex] == COLOR_MAP_NONE)
-        {
-            // No color map. Simply blend the colors.
-            BlendPalette(palOffset, 16, blendCoeff, blendColor);
-            palOffset += 16;
-        }
-        else
-        {
-            for (i = 0; i < 16; i++)
-            {
-                u32 offset;
-                struct RGBColor color1;
-                struct RGBColor color2;
-                u8 r1, g1, b1;
-                u8 r2, g2, b2;
-
-                color1 = *(struct RGBColor *)&gPlttBufferUnfaded[palOffset];
-                r1 = color1.r;
-                g1 = color1.g;
-                b1 = color1.b;
-
-                offset = ((b1 & 0x1E) << 7) | ((g1 & 0x1E) << 3) | ((r1 & 0x1E) >> 1);
-                color2 = *(struct RGBColor *)&sDroughtWeatherColors[colorMapIndex][offset];
-                r2 = color2.r;
-                g2 = color2.g;
-                b2 = color2.b;
-
-                r2 += ((rBlend - r2) * blendCoeff) >> 4;
-                g2 += ((gBlend - g2) * blendCoeff) >> 4;
-                b2 += ((bBlend - b2) * blendCoeff) >> 4;
-
-                gPlttBufferFaded[palOffset++] = RGB2(r2, g2, b2);
-            }
-        }
-    }
-}
-
 static void ApplyFogBlend(u8 blendCoeff, u16 blendColor)
 {
     struct RGBColor color;
@@ -822,6 +793,7 @@ void UpdateSpritePaletteWithWeather(u8 spritePaletteIndex)
             paletteIndex = PLTT_ID(paletteIndex);
             for (i = 0; i < 16; i++)
                 gPlttBufferFaded[paletteIndex + i] = gWeatherPtr->fadeDestColor;
+            MarkPlttBufferDirty(paletteIndex, PLTT_SIZE_4BPP);
         }
         break;
     case WEATHER_PAL_STATE_SCREEN_FADING_OUT:
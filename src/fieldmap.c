@@ -1,10 +1,12 @@
 #include "global.h"
 #include "battle_pyramid.h"
 #include "bg.h"
+#include "decompress.h"
 #include "fieldmap.h"
 #include "fldeff.h"
 #include "fldeff_misc.h"
 #include "frontier_util.h"
+#include "malloc.h"
 #include "menu.h"
 #include "mirage_tower.h"
 #include "overworld.h"
@@ -12,6 +14,7 @@
 #include "pokenav.h"
 #include "script.h"
 #include "secret_base.h"
+#include "task.h"
 #include "trainer_hill.h"
 #include "tv.h"
 #include "constants/rgb.h"
@@ -29,6 +32,10 @@ EWRAM_DATA static u16 ALIGNED(4) sBackupMapData[MAX_MAP_DATA_SIZE] = {0};
 EWRAM_DATA struct MapHeader gMapHeader = {0};
 EWRAM_DATA struct Camera gCamera = {0};
 EWRAM_DATA static struct ConnectionFlags sMapConnectionFlags = {0};
+EWRAM_DATA static const struct Tileset *sPrefetchedTilesets[2] = {0}; // Primary, secondary
+EWRAM_DATA static void *sPrefetchedTiles[2] = {0};
+EWRAM_DATA static const struct Tileset *sResidentTilesets[2] = {0}; // Primary, secondary
+EWRAM_DATA static u32 sResidentTilesetsBgInitCount = 0;
 EWRAM_DATA static u32 UNUSED sFiller = 0; // without this, the next file won't align properly
 
 COMMON_DATA struct BackupMapLayout gBackupMapLayout = {0};
@@ -372,6 +379,34 @@ u32 MapGridGetMetatileIdAt(int x, int y)
     return UNPACK_METATILE(block);
 }
 
+// Same as calling MapGridGetMetatileIdAt for count metatiles in a line starting
+// at (x, y), going down if vertical is TRUE or right otherwise. Lines within the
+// map grid, which is all of them for the camera, are read straight from it.
+void MapGridGetMetatileIdsInLine(int x, int y, bool32 vertical, u16 *metatileIds, u32 count)
+{
+    const u16 *block;
+    u32 i, stride;
+    int endX = vertical ? x : x + (int)count - 1;
+    int endY = vertical ? y + (int)count - 1 : y;
+
+    if (!AreCoordsWithinMapGridBounds(x, y) || !AreCoordsWithinMapGridBounds(endX, endY))
+    {
+        for (i = 0; i < count; i++)
+            metatileIds[i] = vertical ? MapGridGetMetatileIdAt(x, y + i) : MapGridGetMetatileIdAt(x + i, y);
+        return;
+    }
+
+    block = &gBackupMapLayout.map[x + gBackupMapLayout.width * y];
+    stride = vertical ? gBackupMapLayout.width : 1;
+    for (i = 0; i < count; i++, block += stride)
+    {
+        if (*block == MAPGRID_UNDEFINED)
+            metatileIds[i] = vertical ? MapGridGetMetatileIdAt(x, y + i) : MapGridGetMetatileIdAt(x + i, y);
+        else
+            metatileIds[i] = UNPACK_METATILE(*block);
+    }
+}
+
 u32 MapGridGetMetatileBehaviorAt(int x, int y)
 {
     u16 metatile = MapGridGetMetatileIdAt(x, y);
@@ -839,25 +874,124 @@ static bool8 SkipCopyingMetatileFromSavedMap(u16 *mapBlock, u16 mapWidth, u8 yMo
     return FALSE;
 }
 
+// The map's tilesets stay in BG tile VRAM between map loads as long as nothing
+// else uses it, so loading a map that shares a tileset with the last one (e.g.
+// walking between two buildings, or crossing into a connected map) can skip
+// decompressing and uploading it again.
+static const u32 sTilesetVramOffsets[] = {0, NUM_TILES_IN_PRIMARY * TILE_SIZE_4BPP};
+static const u32 sTilesetVramSizes[] = {NUM_TILES_IN_PRIMARY * TILE_SIZE_4BPP, (NUM_TILES_TOTAL - NUM_TILES_IN_PRIMARY) * TILE_SIZE_4BPP};
+
+#define GetTilesetSlot(tileOffset) ((tileOffset) < NUM_TILES_IN_PRIMARY ? 0 : 1)
+
+// Forgets which tilesets are in VRAM, so they're uploaded again on the next map
+// load. Anything that writes to BG tile VRAM without first setting up its
+// backgrounds with InitBgsFromTemplates needs to call this.
+void InvalidateResidentTilesets(void)
+{
+    sResidentTilesets[0] = NULL;
+    sResidentTilesets[1] = NULL;
+    sResidentTilesetsBgInitCount = GetBgTemplateInitCount();
+}
+
+// Any other screen that set up its backgrounds since is assumed to have
+// overwritten the tilesets.
+static void ValidateResidentTilesets(void)
+{
+    if (sResidentTilesetsBgInitCount != GetBgTemplateInitCount())
+        InvalidateResidentTilesets();
+}
+
+static bool32 IsTilesetResident(u32 slot, struct Tileset const *tileset)
+{
+    ValidateResidentTilesets();
+    return tileset != NULL && sResidentTilesets[slot] == tileset;
+}
+
+static void SetTilesetResident(u32 slot, struct Tileset const *tileset)
+{
+    ValidateResidentTilesets();
+    sResidentTilesets[slot] = tileset;
+}
+
+// The overworld setting up its own backgrounds leaves the tilesets alone, so
+// unless another screen did so in between they're still resident afterwards.
+void KeepResidentTilesetsAfterBgInit(u32 prevBgInitCount)
+{
+    if (sResidentTilesetsBgInitCount == prevBgInitCount)
+        sResidentTilesetsBgInitCount = GetBgTemplateInitCount();
+}
+
+static void ClearVramRange(u32 start, u32 end)
+{
+    if (end > start + 0x1000)
+    {
+        DmaFillLarge16(3, 0, (void *)start, end - start, 0x1000);
+    }
+    else if (end > start)
+    {
+        DmaFill16(3, 0, (void *)start, end - start);
+    }
+}
+
+// Clears VRAM for a map load, except for the resident tilesets that mapLayout
+// uses. Without a layout every resident tileset is kept.
+void ClearVramExceptResidentTilesets(struct MapLayout const *mapLayout)
+{
+    u32 slot, start, regionStart, tilesetVram;
+    u32 charBaseIndex = GetBgAttribute(2, BG_ATTR_CHARBASEINDEX);
+
+    // BG2 isn't set up, so there's no telling where the tilesets are
+    if (charBaseIndex == 0xFF)
+    {
+        InvalidateResidentTilesets();
+        ClearVramRange(VRAM, VRAM + VRAM_SIZE);
+        return;
+    }
+
+    tilesetVram = BG_CHAR_ADDR(charBaseIndex);
+    ValidateResidentTilesets();
+    if (mapLayout != NULL)
+    {
+        if (sResidentTilesets[0] != mapLayout->primaryTileset)
+            sResidentTilesets[0] = NULL;
+        if (sResidentTilesets[1] != mapLayout->secondaryTileset)
+            sResidentTilesets[1] = NULL;
+    }
+
+    start = VRAM;
+    for (slot = 0; slot < ARRAY_COUNT(sResidentTilesets); slot++)
+    {
+        if (sResidentTilesets[slot] != NULL)
+        {
+            regionStart = tilesetVram + sTilesetVramOffsets[slot];
+            ClearVramRange(start, regionStart);
+            start = regionStart + sTilesetVramSizes[slot];
+        }
+    }
+    ClearVramRange(start, VRAM + VRAM_SIZE);
+}
+
 static void CopyTilesetToVram(struct Tileset const *tileset, u16 numTiles, u16 offset)
 {
-    if (tileset)
+    if (tileset && !IsTilesetResident(GetTilesetSlot(offset), tileset))
     {
         if (!tileset->isCompressed)
             LoadBgTiles(2, tileset->tiles, numTiles * 32, offset);
         else
             DecompressAndCopyTileDataToVram(2, tileset->tiles, numTiles * 32, offset, 0);
+        SetTilesetResident(GetTilesetSlot(offset), tileset);
     }
 }
 
 static void CopyTilesetToVramUsingHeap(struct Tileset const *tileset, u16 numTiles, u16 offset)
 {
-    if (tileset)
+    if (tileset && !IsTilesetResident(GetTilesetSlot(offset), tileset))
     {
         if (!tileset->isCompressed)
             LoadBgTiles(2, tileset->tiles, numTiles * 32, offset);
         else
             DecompressAndLoadBgGfxUsingHeap(2, tileset->tiles, numTiles * 32, offset, 0);
+        SetTilesetResident(GetTilesetSlot(offset), tileset);
     }
 }
 
@@ -897,6 +1031,83 @@ static void LoadTilesetPalette(struct Tileset const *tileset, u16 destOffset, u1
     }
 }
 
+// Decompresses the tilesets of the map being warped to onto the heap, one per
+// frame, so the work is done while the screen is still fading out.
+static void Task_PrefetchMapTilesets(u8 taskId)
+{
+    u32 i, size;
+
+    for (i = 0; i < ARRAY_COUNT(sPrefetchedTilesets); i++)
+    {
+        if (sPrefetchedTilesets[i] != NULL && sPrefetchedTiles[i] == NULL)
+        {
+            sPrefetchedTiles[i] = malloc_and_decompress(sPrefetchedTilesets[i]->tiles, &size);
+            if (sPrefetchedTiles[i] == NULL)
+                sPrefetchedTilesets[i] = NULL;
+            return;
+        }
+    }
+    DestroyTask(taskId);
+}
+
+void PrefetchMapTilesets(struct MapLayout const *mapLayout)
+{
+    if (mapLayout == NULL || FuncIsActiveTask(Task_PrefetchMapTilesets) == TRUE)
+        return;
+
+    // Anything left over from a prefetch that was never used was freed along
+    // with the rest of the heap when the last map loaded.
+    sPrefetchedTilesets[0] = mapLayout->primaryTileset;
+    sPrefetchedTilesets[1] = mapLayout->secondaryTileset;
+    sPrefetchedTiles[0] = NULL;
+    sPrefetchedTiles[1] = NULL;
+    if (sPrefetchedTilesets[0] != NULL && (!sPrefetchedTilesets[0]->isCompressed || IsTilesetResident(0, sPrefetchedTilesets[0])))
+        sPrefetchedTilesets[0] = NULL;
+    if (sPrefetchedTilesets[1] != NULL && (!sPrefetchedTilesets[1]->isCompressed || IsTilesetResident(1, sPrefetchedTilesets[1])))
+        sPrefetchedTilesets[1] = NULL;
+
+    CreateTask(Task_PrefetchMapTilesets, 80);
+}
+
+static void CopyPrefetchedTilesetToVram(u32 slot, struct Tileset const *tileset, u16 numTiles, void *dest)
+{
+    u32 size;
+
+    if (sPrefetchedTiles[slot] == NULL)
+        return;
+
+    if (sPrefetchedTilesets[slot] != tileset)
+    {
+        FREE_AND_SET_NULL(sPrefetchedTiles[slot]);
+        return;
+    }
+
+    size = GetDecompressedDataSize(tileset->tiles);
+    if (size > numTiles * TILE_SIZE_4BPP)
+        size = numTiles * TILE_SIZE_4BPP;
+    CpuFastCopy(sPrefetchedTiles[slot], dest, size);
+    FREE_AND_SET_NULL(sPrefetchedTiles[slot]);
+    SetTilesetResident(slot, tileset);
+}
+
+// Copies whichever of the map's tilesets were prefetched by PrefetchMapTilesets
+// straight into the cleared BG tile VRAM at tilesDest and marks them resident, so
+// CopyPrimaryTilesetToVram and CopySecondaryTilesetToVram skip them. This has to
+// happen before the heap is reset at the start of the map load.
+void CopyPrefetchedTilesetsToVram(struct MapLayout const *mapLayout, void *tilesDest)
+{
+    if (mapLayout != NULL)
+    {
+        CopyPrefetchedTilesetToVram(0, mapLayout->primaryTileset, NUM_TILES_IN_PRIMARY, tilesDest);
+        CopyPrefetchedTilesetToVram(1, mapLayout->secondaryTileset, NUM_TILES_TOTAL - NUM_TILES_IN_PRIMARY,
+                                    tilesDest + NUM_TILES_IN_PRIMARY * TILE_SIZE_4BPP);
+    }
+    sPrefetchedTilesets[0] = NULL;
+    sPrefetchedTilesets[1] = NULL;
+    sPrefetchedTiles[0] = NULL;
+    sPrefetchedTiles[1] = NULL;
+}
+
 void CopyPrimaryTilesetToVram(struct MapLayout const *mapLayout)
 {
     CopyTilesetToVram(mapLayout->primaryTileset, NUM_TILES_IN_PRIMARY, 0);
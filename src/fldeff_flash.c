@@ -3,6 +3,7 @@
 #include "event_data.h"
 #include "event_scripts.h"
 #include "field_effect.h"
+#include "fieldmap.h"
 #include "fldeff.h"
 #include "gpu_regs.h"
 #include "main.h"
@@ -135,7 +136,7 @@ void CB2_DoChangeMap(void)
     SetGpuReg(REG_OFFSET_BG1VOFS, 0);
     SetGpuReg(REG_OFFSET_BG0HOFS, 0);
     SetGpuReg(REG_OFFSET_BG0VOFS, 0);
-    DmaFill16(3, 0, (void *)VRAM, VRAM_SIZE);
+    ClearVramExceptResidentTilesets(NULL);
     DmaFill32(3, 0, (void *)OAM, OAM_SIZE);
     DmaFill16(3, 0, (void *)(PLTT + 2), PLTT_SIZE - 2);
     ResetPaletteFade();
@@ -0,0 +1,86 @@
+#include "global.h"
+#include "frame_profiler.h"
+#include "sprite.h"
+
+#ifdef FRAME_PROFILER
+
+EWRAM_DATA struct FrameProfiler gFrameProfiler = {0};
+
+static u32 sFrameStart;
+static u8 sDepth;
+
+// Timer 3 counts Timer 2's overflows. If Timer 3 ticks between the two reads,
+// the low half has just wrapped, so read both again.
+static u32 ReadCycleCounter(void)
+{
+    u16 high, low;
+
+    do
+    {
+        high = REG_TM3CNT_L;
+        low = REG_TM2CNT_L;
+    } while (high != REG_TM3CNT_L);
+
+    return (high << 16) | low;
+}
+
+void FrameProfiler_Init(void)
+{
+    CpuFill32(0, &gFrameProfiler, sizeof(gFrameProfiler));
+    gFrameProfiler.magic = FRAME_PROFILER_MAGIC;
+    gFrameProfiler.numEntries = FRAME_PROFILER_NUM_ENTRIES;
+
+    REG_TM2CNT_H = 0;
+    REG_TM3CNT_H = 0;
+    REG_TM2CNT_L = 0;
+    REG_TM3CNT_L = 0;
+    REG_TM3CNT_H = TIMER_ENABLE | TIMER_COUNTUP;
+    REG_TM2CNT_H = TIMER_ENABLE | TIMER_1CLK;
+}
+
+static void AddEntry(u32 func, u32 cycles, u8 depth, u8 kind)
+{
+    struct FrameProfileEntry *entry = &gFrameProfiler.entries[gFrameProfiler.head];
+
+    if (cycles > FRAME_PROFILER_MAX_CYCLES)
+        cycles = FRAME_PROFILER_MAX_CYCLES;
+
+    entry->func = func;
+    entry->cycles = cycles;
+    entry->depth = depth;
+    entry->kind = kind;
+
+    if (++gFrameProfiler.head >= FRAME_PROFILER_NUM_ENTRIES)
+        gFrameProfiler.head = 0;
+    gFrameProfiler.totalEntries++;
+}
+
+void FrameProfiler_BeginFrame(void)
+{
+    sDepth = 0;
+    sFrameStart = ReadCycleCounter();
+}
+
+void FrameProfiler_EndFrame(void)
+{
+    AddEntry(gFrameProfiler.frameCount++, ReadCycleCounter() - sFrameStart, 0, PROFILE_FRAME);
+}
+
+u32 FrameProfiler_BeginCall(void)
+{
+    sDepth++;
+    return ReadCycleCounter();
+}
+
+void FrameProfiler_EndCall(u32 start, const void *func, u8 kind)
+{
+    u32 cycles = ReadCycleCounter() - start;
+
+    // Most sprites sit on SpriteCallbackDummy. Recording them would flood the
+    // ring buffer with calls that take no time.
+    if (func != SpriteCallbackDummy)
+        AddEntry((u32)func, cycles, sDepth, kind);
+    sDepth--;
+}
+
+#endif // FRAME_PROFILER
@@ -23,6 +23,7 @@
 #include "intro.h"
 #include "main.h"
 #include "trainer_hill.h"
+#include "frame_profiler.h"
 #include "constants/rgb.h"
 
 static void VBlankIntr(void);
@@ -112,6 +113,7 @@ void AgbMain(void)
     ResetBgs();
     SetDefaultFontsPointer();
     InitHeap(gHeap, HEAP_SIZE);
+    FrameProfiler_Init();
 
     gSoftResetDisabled = FALSE;
 
@@ -130,6 +132,7 @@ void AgbMain(void)
 #endif
     for (;;)
     {
+        FrameProfiler_BeginFrame();
         ReadKeys();
 
         if (gSoftResetDisabled == FALSE
@@ -164,6 +167,7 @@ void AgbMain(void)
 
         PlayTimeCounter_Update();
         MapMusicMain();
+        FrameProfiler_EndFrame();
         WaitForVBlank();
     }
 }
@@ -188,10 +192,10 @@ static void InitMainCallbacks(void)
 static void CallCallbacks(void)
 {
     if (gMain.callback1)
-        gMain.callback1();
+        PROFILE_CALL(PROFILE_CALLBACK1, gMain.callback1, gMain.callback1());
 
     if (gMain.callback2)
-        gMain.callback2();
+        PROFILE_CALL(PROFILE_CALLBACK2, gMain.callback2, gMain.callback2());
 }
 
 void SetMainCallback2(MainCallback callback)
@@ -373,7 +377,12 @@ static void VBlankIntr(void)
 
 void InitFlashTimer(void)
 {
+#ifdef FRAME_PROFILER
+    // Timer 2 is part of the profiler's cycle counter
+    SetFlashTimerIntr(1, gIntrTable + 0x6);
+#else
     SetFlashTimerIntr(2, gIntrTable + 0x7);
+#endif
 }
 
 static void HBlankIntr(void)
@@ -1059,11 +1059,13 @@ static void Task_HandleMainMenuAPressed(u8 taskId)
             default:
                 gPlttBufferUnfaded[0] = RGB_BLACK;
                 gPlttBufferFaded[0] = RGB_BLACK;
+                MarkPlttBufferDirty(0, PLTT_SIZEOF(1));
                 gTasks[taskId].func = Task_NewGameBirchSpeech_Init;
                 break;
             case ACTION_CONTINUE:
                 gPlttBufferUnfaded[0] = RGB_BLACK;
                 gPlttBufferFaded[0] = RGB_BLACK;
+                MarkPlttBufferDirty(0, PLTT_SIZEOF(1));
                 SetMainCallback2(CB2_ContinueSavedGame);
                 DestroyTask(taskId);
                 break;
@@ -1089,6 +1091,7 @@ static void Task_HandleMainMenuAPressed(u8 taskId)
                 gTasks[taskId].func = Task_DisplayMainMenuInvalidActionError;
                 gPlttBufferUnfaded[BG_PLTT_ID(15) + 1] = RGB_WHITE;
                 gPlttBufferFaded[BG_PLTT_ID(15) + 1] = RGB_WHITE;
+                MarkPlttBufferDirty(BG_PLTT_ID(15) + 1, PLTT_SIZEOF(1));
                 SetGpuReg(REG_OFFSET_BG2HOFS, 0);
                 SetGpuReg(REG_OFFSET_BG2VOFS, 0);
                 SetGpuReg(REG_OFFSET_BG1HOFS, 0);
@@ -8,217 +8,418 @@ ALIGNED(4) EWRAM_DATA u8 gHeap[HEAP_SIZE] = {0};
 
 #define MALLOC_SYSTEM_ID 0xA3A3
 
-struct MemBlock {
-    // Whether this block is currently allocated.
-    bool16 flag;
+// Free blocks are kept in bins by size so Alloc doesn't have to walk the heap.
+// Small sizes get one bin per size (4, 8, ... 128 bytes), so a small request
+// is served by popping the head of its bin. Larger blocks share a bin per
+// power of two.
+#define NUM_SMALL_BINS 32
+#define SMALL_BIN_MAX_SIZE (NUM_SMALL_BINS * 4)
+#define NUM_LARGE_BINS 12
+#define NUM_BINS (NUM_SMALL_BINS + NUM_LARGE_BINS)
+#define NUM_BIN_BITMAP_WORDS ((NUM_BINS + 31) / 32)
 
+struct MemBlock {
     // Magic number used for error checking. Should equal MALLOC_SYSTEM_ID.
     u16 magic;
 
+    // Whether this block is currently allocated.
+    bool8 allocated;
+
+    // The bin this block is in, if it's free.
+    u8 bin;
+
     // Size of the block (not including this header struct).
     u32 size;
 
-    // Previous block pointer. Equals sHeapStart if this is the first block.
+    // The block directly before this one in memory. NULL if this is the first block.
     struct MemBlock *prev;
 
-    // Next block pointer. Equals sHeapStart if this is the last block.
-    struct MemBlock *next;
+    // Neighbors in this block's bin, if it's free. These are kept in the
+    // header rather than in the freed data, because some code still reads
+    // memory shortly after freeing it.
+    struct MemBlock *prevFree;
+    struct MemBlock *nextFree;
 
     // Data in the memory block. (Arrays of length 0 are a GNU extension.)
     u8 data[0];
 };
 
-void PutMemBlockHeader(void *block, struct MemBlock *prev, struct MemBlock *next, u32 size)
+struct ArenaChunk
+{
+    struct ArenaChunk *next;
+    u32 size;
+    u32 used;
+    u8 data[0];
+};
+
+static EWRAM_DATA struct MemBlock *sBins[NUM_BINS] = {0};
+static EWRAM_DATA u32 sNonEmptyBins[NUM_BIN_BITMAP_WORDS] = {0};
+static EWRAM_DATA u32 sUsedSize = 0;
+static EWRAM_DATA u32 sHighWaterMark = 0;
+static EWRAM_DATA u16 sNumAllocations = 0;
+
+static u32 GetBin(u32 size)
+{
+    u32 bin;
+
+    if (size <= SMALL_BIN_MAX_SIZE)
+        return size / 4 - 1;
+
+    bin = NUM_SMALL_BINS;
+    for (size /= SMALL_BIN_MAX_SIZE * 2; size != 0 && bin < NUM_BINS - 1; size /= 2)
+        bin++;
+
+    return bin;
+}
+
+// Returns the first bin at or after startBin that has a free block, or NUM_BINS.
+static u32 FindNonEmptyBin(u32 startBin)
+{
+    u32 bin = startBin;
+
+    while (bin < NUM_BINS)
+    {
+        u32 bits = sNonEmptyBins[bin / 32] >> (bin % 32);
+
+        if (bits == 0)
+        {
+            bin = (bin / 32 + 1) * 32;
+            continue;
+        }
+
+        while (!(bits & 1))
+        {
+            bits >>= 1;
+            bin++;
+        }
+        return bin;
+    }
+
+    return NUM_BINS;
+}
+
+static struct MemBlock *GetNextBlock(struct MemBlock *block)
+{
+    struct MemBlock *next = (struct MemBlock *)(block->data + block->size);
+
+    if ((u8 *)next >= (u8 *)sHeapStart + sHeapSize)
+        return NULL;
+
+    return next;
+}
+
+static void InsertFreeBlock(struct MemBlock *block)
+{
+    u32 bin = GetBin(block->size);
+
+    block->allocated = FALSE;
+    block->bin = bin;
+    block->prevFree = NULL;
+    block->nextFree = sBins[bin];
+    if (sBins[bin] != NULL)
+        sBins[bin]->prevFree = block;
+    sBins[bin] = block;
+    sNonEmptyBins[bin / 32] |= 1u << (bin % 32);
+}
+
+static void RemoveFreeBlock(struct MemBlock *block)
+{
+    u32 bin = block->bin;
+
+    if (block->prevFree != NULL)
+        block->prevFree->nextFree = block->nextFree;
+    else
+        sBins[bin] = block->nextFree;
+
+    if (block->nextFree != NULL)
+        block->nextFree->prevFree = block->prevFree;
+
+    if (sBins[bin] == NULL)
+        sNonEmptyBins[bin / 32] &= ~(1u << (bin % 32));
+}
+
+static void PutMemBlockHeader(void *block, struct MemBlock *prev, u32 size)
 {
     struct MemBlock *header = (struct MemBlock *)block;
 
-    header->flag = FALSE;
     header->magic = MALLOC_SYSTEM_ID;
+    header->allocated = FALSE;
     header->size = size;
     header->prev = prev;
-    header->next = next;
 }
 
-void PutFirstMemBlockHeader(void *block, u32 size)
+// Large bins are searched for the smallest block that fits, which keeps big
+// blocks intact for the screens that need most of the heap.
+static struct MemBlock *FindBestFitInBin(u32 bin, u32 size)
 {
-    PutMemBlockHeader(block, (struct MemBlock *)block, (struct MemBlock *)block, size - sizeof(struct MemBlock));
+    struct MemBlock *block;
+    struct MemBlock *bestBlock = NULL;
+
+    for (block = sBins[bin]; block != NULL; block = block->nextFree)
+    {
+        if (block->size >= size && (bestBlock == NULL || block->size < bestBlock->size))
+        {
+            bestBlock = block;
+            if (block->size == size)
+                break;
+        }
+    }
+
+    return bestBlock;
 }
 
-void *AllocInternal(void *heapStart, u32 size)
+static struct MemBlock *FindFreeBlock(u32 size)
 {
-    struct MemBlock *pos = (struct MemBlock *)heapStart;
-    struct MemBlock *head = pos;
-    struct MemBlock *splitBlock;
-    u32 foundBlockSize;
+    u32 bin = GetBin(size);
+    struct MemBlock *block = NULL;
+
+    // Blocks in a small bin are exactly the requested size, but a large bin
+    // can also hold blocks that are too small.
+    if (bin >= NUM_SMALL_BINS)
+    {
+        block = FindBestFitInBin(bin, size);
+        if (block != NULL)
+            return block;
+        bin++;
+    }
+
+    // Every block in a later bin is big enough.
+    bin = FindNonEmptyBin(bin);
+    if (bin >= NUM_BINS)
+        return NULL;
+    if (bin < NUM_SMALL_BINS)
+        return sBins[bin];
+
+    return FindBestFitInBin(bin, size);
+}
+
+void *Alloc(u32 size)
+{
+    struct MemBlock *block;
 
     // Alignment
-    if (size & 3)
+    if (size == 0)
+        size = 4;
+    else if (size & 3)
         size = 4 * ((size / 4) + 1);
 
-    for (;;)
+    block = FindFreeBlock(size);
+    if (block == NULL)
+        return NULL;
+
+    RemoveFreeBlock(block);
+
+    if (block->size - size >= 2 * sizeof(struct MemBlock))
     {
-        // Loop through the blocks looking for unused block that's big enough.
+        // The block is significantly bigger than the requested size, so
+        // split the rest into a separate block.
+        struct MemBlock *splitBlock = (struct MemBlock *)(block->data + size);
+        struct MemBlock *next;
 
-        if (!pos->flag)
-        {
-            foundBlockSize = pos->size;
-
-            if (foundBlockSize >= size)
-            {
-                if (foundBlockSize - size < 2 * sizeof(struct MemBlock))
-                {
-                    // The block isn't much bigger than the requested size,
-                    // so just use it.
-                    pos->flag = TRUE;
-                }
-                else
-                {
-                    // The block is significantly bigger than the requested
-                    // size, so split the rest into a separate block.
-                    foundBlockSize -= sizeof(struct MemBlock);
-                    foundBlockSize -= size;
-
-                    splitBlock = (struct MemBlock *)(pos->data + size);
-
-                    pos->flag = TRUE;
-                    pos->size = size;
-
-                    PutMemBlockHeader(splitBlock, pos, pos->next, foundBlockSize);
-
-                    pos->next = splitBlock;
-
-                    if (splitBlock->next != head)
-                        splitBlock->next->prev = splitBlock;
-                }
-
-                return pos->data;
-            }
-        }
+        PutMemBlockHeader(splitBlock, block, block->size - size - sizeof(struct MemBlock));
+        block->size = size;
 
-        if (pos->next == head)
-            return NULL;
+        next = GetNextBlock(splitBlock);
+        if (next != NULL)
+            next->prev = splitBlock;
 
-        pos = pos->next;
+        InsertFreeBlock(splitBlock);
     }
+
+    block->allocated = TRUE;
+    sNumAllocations++;
+    sUsedSize += sizeof(struct MemBlock) + block->size;
+    if (sUsedSize > sHighWaterMark)
+        sHighWaterMark = sUsedSize;
+
+    return block->data;
 }
 
-void FreeInternal(void *heapStart, void *pointer)
+void *AllocZeroed(u32 size)
+{
+    void *mem = Alloc(size);
+
+    if (mem != NULL)
+    {
+        if (size & 3)
+            size = 4 * ((size / 4) + 1);
+
+        CpuFill32(0, mem, size);
+    }
+
+    return mem;
+}
+
+void Free(void *pointer)
 {
     if (pointer)
     {
-        struct MemBlock *head = (struct MemBlock *)heapStart;
         struct MemBlock *block = (struct MemBlock *)((u8 *)pointer - sizeof(struct MemBlock));
-        block->flag = FALSE;
+        struct MemBlock *next = GetNextBlock(block);
+
+        sNumAllocations--;
+        sUsedSize -= sizeof(struct MemBlock) + block->size;
+        block->allocated = FALSE;
 
-        // If the freed block isn't the last one, merge with the next block
-        // if it's not in use.
-        if (block->next != head)
+        // Merge with the next block if it's not in use.
+        if (next != NULL && !next->allocated)
         {
-            if (!block->next->flag)
-            {
-                block->size += sizeof(struct MemBlock) + block->next->size;
-                block->next->magic = 0;
-                block->next = block->next->next;
-                if (block->next != head)
-                    block->next->prev = block;
-            }
+            RemoveFreeBlock(next);
+            block->size += sizeof(struct MemBlock) + next->size;
+            next->magic = 0;
         }
 
-        // If the freed block isn't the first one, merge with the previous block
-        // if it's not in use.
-        if (block != head)
+        // Merge with the previous block if it's not in use.
+        if (block->prev != NULL && !block->prev->allocated)
         {
-            if (!block->prev->flag)
-            {
-                block->prev->next = block->next;
+            struct MemBlock *prev = block->prev;
 
-                if (block->next != head)
-                    block->next->prev = block->prev;
-
-                block->magic = 0;
-                block->prev->size += sizeof(struct MemBlock) + block->size;
-            }
+            RemoveFreeBlock(prev);
+            prev->size += sizeof(struct MemBlock) + block->size;
+            block->magic = 0;
+            block = prev;
         }
+
+        next = GetNextBlock(block);
+        if (next != NULL)
+            next->prev = block;
+
+        InsertFreeBlock(block);
     }
 }
 
-void *AllocZeroedInternal(void *heapStart, u32 size)
+void InitHeap(void *heapStart, u32 heapSize)
 {
-    void *mem = AllocInternal(heapStart, size);
+    u32 i;
 
-    if (mem != NULL)
-    {
-        if (size & 3)
-            size = 4 * ((size / 4) + 1);
+    sHeapStart = heapStart;
+    sHeapSize = heapSize;
 
-        CpuFill32(0, mem, size);
-    }
+    for (i = 0; i < NUM_BINS; i++)
+        sBins[i] = NULL;
+    for (i = 0; i < NUM_BIN_BITMAP_WORDS; i++)
+        sNonEmptyBins[i] = 0;
+    sUsedSize = 0;
+    sHighWaterMark = 0;
+    sNumAllocations = 0;
 
-    return mem;
+    PutMemBlockHeader(heapStart, NULL, heapSize - sizeof(struct MemBlock));
+    InsertFreeBlock(heapStart);
 }
 
-bool32 CheckMemBlockInternal(void *heapStart, void *pointer)
+bool32 CheckMemBlock(void *pointer)
 {
-    struct MemBlock *head = (struct MemBlock *)heapStart;
     struct MemBlock *block = (struct MemBlock *)((u8 *)pointer - sizeof(struct MemBlock));
+    struct MemBlock *next;
 
     if (block->magic != MALLOC_SYSTEM_ID)
         return FALSE;
 
-    if (block->next->magic != MALLOC_SYSTEM_ID)
-        return FALSE;
-
-    if (block->next != head && block->next->prev != block)
+    if (block->prev != NULL && (block->prev->magic != MALLOC_SYSTEM_ID || GetNextBlock(block->prev) != block))
         return FALSE;
 
-    if (block->prev->magic != MALLOC_SYSTEM_ID)
+    next = GetNextBlock(block);
+    if (next != NULL && (next->magic != MALLOC_SYSTEM_ID || next->prev != block))
         return FALSE;
 
-    if (block->prev != head && block->prev->next != block)
-        return FALSE;
-
-    if (block->next != head && block->next != (struct MemBlock *)(block->data + block->size))
+    // Free blocks are always merged with free neighbors.
+    if (!block->allocated && next != NULL && !next->allocated)
         return FALSE;
 
     return TRUE;
 }
 
-void InitHeap(void *heapStart, u32 heapSize)
+bool32 CheckHeap(void)
 {
-    sHeapStart = heapStart;
-    sHeapSize = heapSize;
-    PutFirstMemBlockHeader(heapStart, heapSize);
+    struct MemBlock *pos = (struct MemBlock *)sHeapStart;
+
+    do {
+        if (!CheckMemBlock(pos->data))
+            return FALSE;
+        pos = GetNextBlock(pos);
+    } while (pos != NULL);
+
+    return TRUE;
 }
 
-void *Alloc(u32 size)
+void GetHeapStats(struct HeapStats *stats)
 {
-    return AllocInternal(sHeapStart, size);
+    struct MemBlock *pos = (struct MemBlock *)sHeapStart;
+
+    stats->heapSize = sHeapSize;
+    stats->usedSize = sUsedSize;
+    stats->highWaterMark = sHighWaterMark;
+    stats->freeSize = 0;
+    stats->largestFreeBlock = 0;
+    stats->numAllocations = sNumAllocations;
+    stats->numFreeBlocks = 0;
+
+    do {
+        if (!pos->allocated)
+        {
+            stats->freeSize += pos->size;
+            stats->numFreeBlocks++;
+            if (pos->size > stats->largestFreeBlock)
+                stats->largestFreeBlock = pos->size;
+        }
+        pos = GetNextBlock(pos);
+    } while (pos != NULL);
 }
 
-void *AllocZeroed(u32 size)
+void ResetHeapHighWaterMark(void)
 {
-    return AllocZeroedInternal(sHeapStart, size);
+    sHighWaterMark = sUsedSize;
 }
 
-void Free(void *pointer)
+// Starts an empty arena. Chunks are allocated on demand, so a screen that
+// passes the total size of its buffers as chunkSize uses a single heap block.
+void ArenaBegin(struct Arena *arena, u32 chunkSize)
 {
-    FreeInternal(sHeapStart, pointer);
+    arena->chunks = NULL;
+    arena->chunkSize = chunkSize;
 }
 
-bool32 CheckMemBlock(void *pointer)
+void *ArenaAlloc(struct Arena *arena, u32 size)
 {
-    return CheckMemBlockInternal(sHeapStart, pointer);
+    struct ArenaChunk *chunk = arena->chunks;
+    void *mem;
+
+    // Alignment
+    if (size == 0)
+        size = 4;
+    else if (size & 3)
+        size = 4 * ((size / 4) + 1);
+
+    if (chunk == NULL || chunk->size - chunk->used < size)
+    {
+        u32 chunkSize = max(arena->chunkSize, size);
+
+        chunk = AllocZeroed(sizeof(struct ArenaChunk) + chunkSize);
+        if (chunk == NULL)
+            return NULL;
+
+        chunk->size = chunkSize;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    mem = chunk->data + chunk->used;
+    chunk->used += size;
+    return mem;
 }
 
-bool32 CheckHeap()
+// Frees everything allocated from the arena. The arena can be used again
+// afterwards.
+void ArenaReset(struct Arena *arena)
 {
-    struct MemBlock *pos = (struct MemBlock *)sHeapStart;
+    struct ArenaChunk *chunk = arena->chunks;
 
-    do {
-        if (!CheckMemBlockInternal(sHeapStart, pos->data))
-            return FALSE;
-        pos = pos->next;
-    } while (pos != (struct MemBlock *)sHeapStart);
+    while (chunk != NULL)
+    {
+        struct ArenaChunk *next = chunk->next;
 
-    return TRUE;
+        Free(chunk);
+        chunk = next;
+    }
+    arena->chunks = NULL;
 }
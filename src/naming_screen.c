@@ -991,6 +991,7 @@ static void RestoreButtonColor(u8 button)
 {
     u16 index = GetButtonPalOffset(button);
     gPlttBufferFaded[index] = gPlttBufferUnfaded[index];
+    MarkPlttBufferDirty(index, PLTT_SIZEOF(1));
 }
 
 static void StartButtonFlash(struct Task *task, u8 button, bool8 keepFlashing)
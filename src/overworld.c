@@ -1400,7 +1400,10 @@ u8 GetCurrentMapBattleScene(void)
 
 static void InitOverworldBgs(void)
 {
+    u32 bgInitCount = GetBgTemplateInitCount();
+
     InitBgsFromTemplates(0, sOverworldBgTemplates, ARRAY_COUNT(sOverworldBgTemplates));
+    KeepResidentTilesetsAfterBgInit(bgInitCount);
     SetBgAttribute(1, BG_ATTR_MOSAIC, 1);
     SetBgAttribute(2, BG_ATTR_MOSAIC, 1);
     SetBgAttribute(3, BG_ATTR_MOSAIC, 1);
@@ -1896,8 +1899,11 @@ static bool32 LoadMapInStepsLocal(u8 *state, bool32 a2)
         (*state)++;
         break;
     case 1:
-        ResetMirageTowerAndSaveBlockPtrs();
+        // Tilesets prefetched during the warp's fade out live on the heap,
+        // so they're copied in after VRAM is cleared but before the heap is reset.
         ResetScreenForMapLoad();
+        CopyPrefetchedTilesetsToVram(gMapHeader.mapLayout, (void *)BG_CHAR_ADDR(sOverworldBgTemplates[2].charBaseIndex));
+        ResetMirageTowerAndSaveBlockPtrs();
         (*state)++;
         break;
     case 2:
@@ -2080,7 +2086,7 @@ static void ResetScreenForMapLoad(void)
     ScanlineEffect_Stop();
 
     DmaClear16(3, PLTT + 2, PLTT_SIZE - 2);
-    DmaFillLarge16(3, 0, (void *)VRAM, VRAM_SIZE, 0x1000);
+    ClearVramExceptResidentTilesets(gMapHeader.mapLayout);
     ResetOamRange(0, 128);
     LoadOam();
 }
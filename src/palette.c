@@ -64,6 +64,7 @@ static EWRAM_DATA struct PaletteStruct sPaletteStructs[NUM_PALETTE_STRUCTS] = {0
 EWRAM_DATA struct PaletteFadeControl gPaletteFade = {0};
 static EWRAM_DATA u32 sFiller = 0;
 static EWRAM_DATA u32 sPlttBufferTransferPending = 0;
+EWRAM_DATA u32 gPlttBufferDirtyPalettes = 0; // palettes changed since the last upload, one bit each
 EWRAM_DATA u8 ALIGNED(2) gPaletteDecompressionBuffer[PLTT_SIZE] = {0};
 
 static const struct PaletteStructTemplate sDummyPaletteStructTemplate = {
@@ -86,27 +87,44 @@ void LoadCompressedPalette(const u32 *src, u16 offset, u16 size)
     LZDecompressWram(src, gPaletteDecompressionBuffer);
     CpuCopy16(gPaletteDecompressionBuffer, &gPlttBufferUnfaded[offset], size);
     CpuCopy16(gPaletteDecompressionBuffer, &gPlttBufferFaded[offset], size);
+    MarkPlttBufferDirty(offset, size);
 }
 
 void LoadPalette(const void *src, u16 offset, u16 size)
 {
     CpuCopy16(src, &gPlttBufferUnfaded[offset], size);
     CpuCopy16(src, &gPlttBufferFaded[offset], size);
+    MarkPlttBufferDirty(offset, size);
 }
 
 void FillPalette(u16 value, u16 offset, u16 size)
 {
     CpuFill16(value, &gPlttBufferUnfaded[offset], size);
     CpuFill16(value, &gPlttBufferFaded[offset], size);
+    MarkPlttBufferDirty(offset, size);
 }
 
 void TransferPlttBuffer(void)
 {
     if (!gPaletteFade.bufferTransferDisabled)
     {
-        void *src = gPlttBufferFaded;
-        void *dest = (void *)PLTT;
-        DmaCopy16(3, src, dest, PLTT_SIZE);
+        u32 dirty = gPlttBufferDirtyPalettes;
+        u32 paletteNum = 0;
+
+        // Upload each run of consecutive changed palettes with one DMA.
+        while (dirty)
+        {
+            u32 count;
+
+            for (; !(dirty & 1); dirty >>= 1)
+                paletteNum++;
+            for (count = 0; dirty & 1; dirty >>= 1)
+                count++;
+
+            DmaCopy16(3, &gPlttBufferFaded[PLTT_ID(paletteNum)], (void *)(PLTT + PLTT_OFFSET_4BPP(paletteNum)), count * PLTT_SIZE_4BPP);
+            paletteNum += count;
+        }
+        gPlttBufferDirtyPalettes = 0;
         sPlttBufferTransferPending = FALSE;
         if (gPaletteFade.mode == HARDWARE_FADE && gPaletteFade.active)
             UpdateBlendRegisters();
@@ -141,6 +159,10 @@ void ResetPaletteFade(void)
         PaletteStruct_Reset(i);
 
     ResetPaletteFadeControl();
+
+    // Screens clear PLTT directly when they set up, so the first
+    // transfer afterwards has to resend everything.
+    gPlttBufferDirtyPalettes = PALETTES_ALL;
 }
 
 static void ReadPlttIntoBuffers(void)
@@ -193,6 +215,7 @@ bool8 BeginNormalPaletteFade(u32 selectedPalettes, s8 delay, u8 startY, u8 targe
         temp = gPaletteFade.bufferTransferDisabled;
         gPaletteFade.bufferTransferDisabled = FALSE;
         CpuCopy32(gPlttBufferFaded, (void *)PLTT, PLTT_SIZE);
+        gPlttBufferDirtyPalettes = 0;
         sPlttBufferTransferPending = FALSE;
         if (gPaletteFade.mode == HARDWARE_FADE && gPaletteFade.active)
             UpdateBlendRegisters();
@@ -279,6 +302,7 @@ static void PaletteStruct_Copy(struct PaletteStruct *palStruct, u32 *unkFlags)
     }
 
     *unkFlags |= 1 << (palStruct->baseDestOffset >> 4);
+    MarkPlttBufferDirty(palStruct->baseDestOffset, PLTT_SIZEOF(palStruct->template->size));
 }
 
 static void PaletteStruct_Blend(struct PaletteStruct *palStruct, u32 *unkFlags)
@@ -307,6 +331,7 @@ static void PaletteStruct_Blend(struct PaletteStruct *palStruct, u32 *unkFlags)
 
                     for (i = 0; i < palStruct->template->size; i++)
                         gPlttBufferFaded[palStruct->baseDestOffset + i] = palStruct->template->src[srcOffset + i];
+                    MarkPlttBufferDirty(palStruct->baseDestOffset, PLTT_SIZEOF(palStruct->template->size));
                 }
             }
         }
@@ -495,6 +520,8 @@ void InvertPlttBuffer(u32 selectedPalettes)
 {
     u16 paletteOffset = 0;
 
+    gPlttBufferDirtyPalettes |= selectedPalettes;
+
     while (selectedPalettes)
     {
         if (selectedPalettes & 1)
@@ -512,6 +539,8 @@ void TintPlttBuffer(u32 selectedPalettes, s8 r, s8 g, s8 b)
 {
     u16 paletteOffset = 0;
 
+    gPlttBufferDirtyPalettes |= selectedPalettes;
+
     while (selectedPalettes)
     {
         if (selectedPalettes & 1)
@@ -534,6 +563,8 @@ void UnfadePlttBuffer(u32 selectedPalettes)
 {
     u16 paletteOffset = 0;
 
+    gPlttBufferDirtyPalettes |= selectedPalettes;
+
     while (selectedPalettes)
     {
         if (selectedPalettes & 1)
@@ -566,6 +597,9 @@ static void BeginFastPaletteFadeInternal(u8 submode)
     if (submode == FAST_FADE_IN_FROM_WHITE)
         CpuFill16(RGB_WHITE, gPlttBufferFaded, PLTT_SIZE);
 
+    if (submode == FAST_FADE_IN_FROM_BLACK || submode == FAST_FADE_IN_FROM_WHITE)
+        gPlttBufferDirtyPalettes = PALETTES_ALL;
+
     UpdatePaletteFade();
 }
 
@@ -592,11 +626,13 @@ static u8 UpdateFastPaletteFade(void)
     {
         paletteOffsetStart = OBJ_PLTT_OFFSET;
         paletteOffsetEnd = PLTT_BUFFER_SIZE;
+        gPlttBufferDirtyPalettes |= PALETTES_OBJECTS;
     }
     else
     {
         paletteOffsetStart = 0;
         paletteOffsetEnd = OBJ_PLTT_OFFSET;
+        gPlttBufferDirtyPalettes |= PALETTES_BG;
     }
 
     switch (gPaletteFade_submode)
@@ -717,6 +753,7 @@ static u8 UpdateFastPaletteFade(void)
             CpuFill32(0x00000000, gPlttBufferFaded, PLTT_SIZE);
             break;
         }
+        gPlttBufferDirtyPalettes = PALETTES_ALL;
 
         gPaletteFade.mode = NORMAL_FADE;
         gPaletteFade.softwareFadeFinishing = TRUE;
@@ -846,6 +883,7 @@ void BlendPalettesUnfaded(u32 selectedPalettes, u8 coeff, u16 color)
     void *src = gPlttBufferUnfaded;
     void *dest = gPlttBufferFaded;
     DmaCopy32(3, src, dest, PLTT_SIZE);
+    gPlttBufferDirtyPalettes = PALETTES_ALL;
     BlendPalettes(selectedPalettes, coeff, color);
 }
 
@@ -119,6 +119,8 @@ static EWRAM_DATA struct PokedexView *sPokedexView = NULL;
 static EWRAM_DATA u16 sLastSelectedPokemon = 0;
 static EWRAM_DATA u8 sPokeBallRotation = 0;
 static EWRAM_DATA struct PokedexListItem *sPokedexListItem = NULL;
+// Holds the BG tilemap buffers of whichever page is loaded
+static EWRAM_DATA struct Arena sTilemapArena = {0};
 
 // This is written to, but never read.
 COMMON_DATA u8 gUnusedPokedexU8 = 0;
@@ -2064,10 +2066,11 @@ static bool8 LoadPokedexListPage(u8 page)
         SetGpuReg(REG_OFFSET_BG2VOFS, sPokedexView->initialVOffset);
         ResetBgsAndClearDma3BusyFlags(0);
         InitBgsFromTemplates(0, sPokedex_BgTemplate, ARRAY_COUNT(sPokedex_BgTemplate));
-        SetBgTilemapBuffer(3, AllocZeroed(BG_SCREEN_SIZE));
-        SetBgTilemapBuffer(2, AllocZeroed(BG_SCREEN_SIZE));
-        SetBgTilemapBuffer(1, AllocZeroed(BG_SCREEN_SIZE));
-        SetBgTilemapBuffer(0, AllocZeroed(BG_SCREEN_SIZE));
+        ArenaBegin(&sTilemapArena, 4 * BG_SCREEN_SIZE);
+        SetBgTilemapBuffer(3, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+        SetBgTilemapBuffer(2, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+        SetBgTilemapBuffer(1, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+        SetBgTilemapBuffer(0, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
         DecompressAndLoadBgGfxUsingHeap(3, gPokedexMenu_Gfx, 0x2000, 0, 0);
         CopyToBgTilemapBuffer(1, gPokedexList_Tilemap, 0, 0);
         CopyToBgTilemapBuffer(3, gPokedexListUnderlay_Tilemap, 0, 0);
@@ -2157,21 +2160,8 @@ static void LoadPokedexBgPalette(bool8 isSearchResults)
 
 static void FreeWindowAndBgBuffers(void)
 {
-    void *tilemapBuffer;
-
     FreeAllWindowBuffers();
-    tilemapBuffer = GetBgTilemapBuffer(0);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(1);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(2);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(3);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
+    ArenaReset(&sTilemapArena);
 }
 
 static void CreatePokedexList(u8 dexMode, u8 order)
@@ -3200,10 +3190,11 @@ static u8 LoadInfoScreen(struct PokedexListItem *item, u8 monSpriteId)
     gTasks[taskId].tTrainerSpriteId = SPRITE_NONE;
     ResetBgsAndClearDma3BusyFlags(0);
     InitBgsFromTemplates(0, sInfoScreen_BgTemplate, ARRAY_COUNT(sInfoScreen_BgTemplate));
-    SetBgTilemapBuffer(3, AllocZeroed(BG_SCREEN_SIZE));
-    SetBgTilemapBuffer(2, AllocZeroed(BG_SCREEN_SIZE));
-    SetBgTilemapBuffer(1, AllocZeroed(BG_SCREEN_SIZE));
-    SetBgTilemapBuffer(0, AllocZeroed(BG_SCREEN_SIZE));
+    ArenaBegin(&sTilemapArena, 4 * BG_SCREEN_SIZE);
+    SetBgTilemapBuffer(3, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+    SetBgTilemapBuffer(2, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+    SetBgTilemapBuffer(1, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+    SetBgTilemapBuffer(0, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
     InitWindows(sInfoScreen_WindowTemplates);
     DeactivateAllTextPrinters();
 
@@ -3343,21 +3334,8 @@ static void Task_LoadInfoScreen(u8 taskId)
 
 static void FreeInfoScreenWindowAndBgBuffers(void)
 {
-    void *tilemapBuffer;
-
     FreeAllWindowBuffers();
-    tilemapBuffer = GetBgTilemapBuffer(0);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(1);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(2);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(3);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
+    ArenaReset(&sTilemapArena);
 }
 
 static void Task_HandleInfoScreenInput(u8 taskId)
@@ -3970,8 +3948,9 @@ static void Task_DisplayCaughtMonDexPage(u8 taskId)
             ResetOtherVideoRegisters(DISPCNT_BG0_ON);
             ResetBgsAndClearDma3BusyFlags(0);
             InitBgsFromTemplates(0, sNewEntryInfoScreen_BgTemplate, ARRAY_COUNT(sNewEntryInfoScreen_BgTemplate));
-            SetBgTilemapBuffer(3, AllocZeroed(BG_SCREEN_SIZE));
-            SetBgTilemapBuffer(2, AllocZeroed(BG_SCREEN_SIZE));
+            ArenaBegin(&sTilemapArena, 2 * BG_SCREEN_SIZE);
+            SetBgTilemapBuffer(3, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+            SetBgTilemapBuffer(2, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
             InitWindows(sNewEntryInfoScreen_WindowTemplates);
             DeactivateAllTextPrinters();
             gTasks[taskId].tState = 1;
@@ -4055,16 +4034,10 @@ static void Task_ExitCaughtMonPage(u8 taskId)
         u32 personality;
         u8 paletteNum;
         const u32 *lzPaletteData;
-        void *buffer;
 
         SetGpuReg(REG_OFFSET_DISPCNT, DISPCNT_OBJ_1D_MAP | DISPCNT_OBJ_ON);
         FreeAllWindowBuffers();
-        buffer = GetBgTilemapBuffer(2);
-        if (buffer)
-            Free(buffer);
-        buffer = GetBgTilemapBuffer(3);
-        if (buffer)
-            Free(buffer);
+        ArenaReset(&sTilemapArena);
 
         species = NationalPokedexNumToSpecies(gTasks[taskId].tDexNum);
         otId = ((u16)gTasks[taskId].tOtIdHi << 16) | (u16)gTasks[taskId].tOtIdLo;
@@ -4843,10 +4816,11 @@ static void Task_LoadSearchMenu(u8 taskId)
             ResetOtherVideoRegisters(0);
             ResetBgsAndClearDma3BusyFlags(0);
             InitBgsFromTemplates(0, sSearchMenu_BgTemplate, ARRAY_COUNT(sSearchMenu_BgTemplate));
-            SetBgTilemapBuffer(3, AllocZeroed(BG_SCREEN_SIZE));
-            SetBgTilemapBuffer(2, AllocZeroed(BG_SCREEN_SIZE));
-            SetBgTilemapBuffer(1, AllocZeroed(BG_SCREEN_SIZE));
-            SetBgTilemapBuffer(0, AllocZeroed(BG_SCREEN_SIZE));
+            ArenaBegin(&sTilemapArena, 4 * BG_SCREEN_SIZE);
+            SetBgTilemapBuffer(3, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+            SetBgTilemapBuffer(2, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+            SetBgTilemapBuffer(1, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
+            SetBgTilemapBuffer(0, ArenaAlloc(&sTilemapArena, BG_SCREEN_SIZE));
             InitWindows(sSearchMenu_WindowTemplate);
             DeactivateAllTextPrinters();
             PutWindowTilemap(0);
@@ -4902,21 +4876,8 @@ static void Task_LoadSearchMenu(u8 taskId)
 
 static void FreeSearchWindowAndBgBuffers(void)
 {
-    void *tilemapBuffer;
-
     FreeAllWindowBuffers();
-    tilemapBuffer = GetBgTilemapBuffer(0);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(1);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(2);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
-    tilemapBuffer = GetBgTilemapBuffer(3);
-    if (tilemapBuffer)
-        Free(tilemapBuffer);
+    ArenaReset(&sTilemapArena);
 }
 
 static void Task_SwitchToSearchMenuTopBar(u8 taskId)
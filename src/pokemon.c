@@ -2931,6 +2931,18 @@ u8 GetLevelFromBoxMonExp(struct BoxPokemon *boxMon)
     return level - 1;
 }
 
+u8 GetLevelFromBoxMonViewExp(struct BoxMonView *view)
+{
+    u16 species = GetBoxMonViewData(view, MON_DATA_SPECIES, NULL);
+    u32 exp = GetBoxMonViewData(view, MON_DATA_EXP, NULL);
+    s32 level = 1;
+
+    while (level <= MAX_LEVEL && gExperienceTables[gSpeciesInfo[species].growthRate][level] <= exp)
+        level++;
+
+    return level - 1;
+}
+
 u16 GiveMoveToMon(struct Pokemon *mon, u16 move)
 {
     return GiveMoveToBoxMon(&mon->box, move);
@@ -3709,36 +3721,11 @@ u32 GetMonData3(struct Pokemon *mon, s32 field, u8 *data)
 
 u32 GetMonData2(struct Pokemon *mon, s32 field) __attribute__((alias("GetMonData3")));
 
-/* GameFreak called GetBoxMonData with either 2 or 3 arguments, for type
- * safety we have a GetBoxMonData macro (in include/pokemon.h) which
- * dispatches to either GetBoxMonData2 or GetBoxMonData3 based on the
- * number of arguments. */
-u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data)
+// Reads a field of a box mon whose substructs have already been decrypted
+static u32 GetDecryptedBoxMonData(struct BoxPokemon *boxMon, struct PokemonSubstruct0 *substruct0, struct PokemonSubstruct1 *substruct1, struct PokemonSubstruct2 *substruct2, struct PokemonSubstruct3 *substruct3, s32 field, u8 *data)
 {
     s32 i;
     u32 retVal = 0;
-    struct PokemonSubstruct0 *substruct0 = NULL;
-    struct PokemonSubstruct1 *substruct1 = NULL;
-    struct PokemonSubstruct2 *substruct2 = NULL;
-    struct PokemonSubstruct3 *substruct3 = NULL;
-
-    // Any field greater than MON_DATA_ENCRYPT_SEPARATOR is encrypted and must be treated as such
-    if (field > MON_DATA_ENCRYPT_SEPARATOR)
-    {
-        substruct0 = &(GetSubstruct(boxMon, boxMon->personality, 0)->type0);
-        substruct1 = &(GetSubstruct(boxMon, boxMon->personality, 1)->type1);
-        substruct2 = &(GetSubstruct(boxMon, boxMon->personality, 2)->type2);
-        substruct3 = &(GetSubstruct(boxMon, boxMon->personality, 3)->type3);
-
-        DecryptBoxMon(boxMon);
-
-        if (CalculateBoxMonChecksum(boxMon) != boxMon->checksum)
-        {
-            boxMon->isBadEgg = TRUE;
-            boxMon->isEgg = TRUE;
-            substruct3->isEgg = TRUE;
-        }
-    }
 
     switch (field)
     {
@@ -4063,6 +4050,41 @@ u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data)
         break;
     }
 
+    return retVal;
+}
+
+/* GameFreak called GetBoxMonData with either 2 or 3 arguments, for type
+ * safety we have a GetBoxMonData macro (in include/pokemon.h) which
+ * dispatches to either GetBoxMonData2 or GetBoxMonData3 based on the
+ * number of arguments. */
+u32 GetBoxMonData3(struct BoxPokemon *boxMon, s32 field, u8 *data)
+{
+    u32 retVal;
+    struct PokemonSubstruct0 *substruct0 = NULL;
+    struct PokemonSubstruct1 *substruct1 = NULL;
+    struct PokemonSubstruct2 *substruct2 = NULL;
+    struct PokemonSubstruct3 *substruct3 = NULL;
+
+    // Any field greater than MON_DATA_ENCRYPT_SEPARATOR is encrypted and must be treated as such
+    if (field > MON_DATA_ENCRYPT_SEPARATOR)
+    {
+        substruct0 = &(GetSubstruct(boxMon, boxMon->personality, 0)->type0);
+        substruct1 = &(GetSubstruct(boxMon, boxMon->personality, 1)->type1);
+        substruct2 = &(GetSubstruct(boxMon, boxMon->personality, 2)->type2);
+        substruct3 = &(GetSubstruct(boxMon, boxMon->personality, 3)->type3);
+
+        DecryptBoxMon(boxMon);
+
+        if (CalculateBoxMonChecksum(boxMon) != boxMon->checksum)
+        {
+            boxMon->isBadEgg = TRUE;
+            boxMon->isEgg = TRUE;
+            substruct3->isEgg = TRUE;
+        }
+    }
+
+    retVal = GetDecryptedBoxMonData(boxMon, substruct0, substruct1, substruct2, substruct3, field, data);
+
     if (field > MON_DATA_ENCRYPT_SEPARATOR)
         EncryptBoxMon(boxMon);
 
@@ -4132,34 +4154,9 @@ void SetMonData(struct Pokemon *mon, s32 field, const void *dataArg)
     }
 }
 
-void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
+// Writes a field of a box mon whose substructs have already been decrypted
+static void SetDecryptedBoxMonData(struct BoxPokemon *boxMon, struct PokemonSubstruct0 *substruct0, struct PokemonSubstruct1 *substruct1, struct PokemonSubstruct2 *substruct2, struct PokemonSubstruct3 *substruct3, s32 field, const u8 *data)
 {
-    const u8 *data = dataArg;
-
-    struct PokemonSubstruct0 *substruct0 = NULL;
-    struct PokemonSubstruct1 *substruct1 = NULL;
-    struct PokemonSubstruct2 *substruct2 = NULL;
-    struct PokemonSubstruct3 *substruct3 = NULL;
-
-    if (field > MON_DATA_ENCRYPT_SEPARATOR)
-    {
-        substruct0 = &(GetSubstruct(boxMon, boxMon->personality, 0)->type0);
-        substruct1 = &(GetSubstruct(boxMon, boxMon->personality, 1)->type1);
-        substruct2 = &(GetSubstruct(boxMon, boxMon->personality, 2)->type2);
-        substruct3 = &(GetSubstruct(boxMon, boxMon->personality, 3)->type3);
-
-        DecryptBoxMon(boxMon);
-
-        if (CalculateBoxMonChecksum(boxMon) != boxMon->checksum)
-        {
-            boxMon->isBadEgg = TRUE;
-            boxMon->isEgg = TRUE;
-            substruct3->isEgg = TRUE;
-            EncryptBoxMon(boxMon);
-            return;
-        }
-    }
-
     switch (field)
     {
     case MON_DATA_PERSONALITY:
@@ -4395,6 +4392,37 @@ void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
     default:
         break;
     }
+}
+
+void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
+{
+    const u8 *data = dataArg;
+
+    struct PokemonSubstruct0 *substruct0 = NULL;
+    struct PokemonSubstruct1 *substruct1 = NULL;
+    struct PokemonSubstruct2 *substruct2 = NULL;
+    struct PokemonSubstruct3 *substruct3 = NULL;
+
+    if (field > MON_DATA_ENCRYPT_SEPARATOR)
+    {
+        substruct0 = &(GetSubstruct(boxMon, boxMon->personality, 0)->type0);
+        substruct1 = &(GetSubstruct(boxMon, boxMon->personality, 1)->type1);
+        substruct2 = &(GetSubstruct(boxMon, boxMon->personality, 2)->type2);
+        substruct3 = &(GetSubstruct(boxMon, boxMon->personality, 3)->type3);
+
+        DecryptBoxMon(boxMon);
+
+        if (CalculateBoxMonChecksum(boxMon) != boxMon->checksum)
+        {
+            boxMon->isBadEgg = TRUE;
+            boxMon->isEgg = TRUE;
+            substruct3->isEgg = TRUE;
+            EncryptBoxMon(boxMon);
+            return;
+        }
+    }
+
+    SetDecryptedBoxMonData(boxMon, substruct0, substruct1, substruct2, substruct3, field, data);
 
     if (field > MON_DATA_ENCRYPT_SEPARATOR)
     {
@@ -4403,6 +4431,67 @@ void SetBoxMonData(struct BoxPokemon *boxMon, s32 field, const void *dataArg)
     }
 }
 
+// Decrypts a copy of boxMon so that several fields can be read without
+// decrypting and checksumming the mon for each one. A bad checksum marks
+// boxMon as a Bad Egg, the same as GetBoxMonData does.
+void LoadBoxMonView(struct BoxMonView *view, struct BoxPokemon *boxMon)
+{
+    view->boxMon = *boxMon;
+    view->substruct0 = &(GetSubstruct(&view->boxMon, view->boxMon.personality, 0)->type0);
+    view->substruct1 = &(GetSubstruct(&view->boxMon, view->boxMon.personality, 1)->type1);
+    view->substruct2 = &(GetSubstruct(&view->boxMon, view->boxMon.personality, 2)->type2);
+    view->substruct3 = &(GetSubstruct(&view->boxMon, view->boxMon.personality, 3)->type3);
+    view->isBadChecksum = FALSE;
+    view->isSecureModified = FALSE;
+
+    DecryptBoxMon(&view->boxMon);
+
+    if (CalculateBoxMonChecksum(&view->boxMon) != view->boxMon.checksum)
+    {
+        view->boxMon.isBadEgg = TRUE;
+        view->boxMon.isEgg = TRUE;
+        view->substruct3->isEgg = TRUE;
+        view->isBadChecksum = TRUE;
+
+        *boxMon = view->boxMon;
+        EncryptBoxMon(boxMon);
+    }
+}
+
+u32 GetBoxMonViewData3(struct BoxMonView *view, s32 field, u8 *data)
+{
+    return GetDecryptedBoxMonData(&view->boxMon, view->substruct0, view->substruct1, view->substruct2, view->substruct3, field, data);
+}
+
+u32 GetBoxMonViewData2(struct BoxMonView *view, s32 field) __attribute__((alias("GetBoxMonViewData3")));
+
+void SetBoxMonViewData(struct BoxMonView *view, s32 field, const void *dataArg)
+{
+    // The personality and OT ID are the encryption key, and the personality
+    // also decides the substruct order, so they can't be changed in a view.
+    if (field == MON_DATA_PERSONALITY || field == MON_DATA_OT_ID)
+        return;
+
+    if (field > MON_DATA_ENCRYPT_SEPARATOR)
+    {
+        // SetBoxMonData refuses to change the encrypted fields of a Bad Egg
+        if (view->isBadChecksum)
+            return;
+        view->isSecureModified = TRUE;
+    }
+
+    SetDecryptedBoxMonData(&view->boxMon, view->substruct0, view->substruct1, view->substruct2, view->substruct3, field, dataArg);
+}
+
+// Encrypts the view's mon into boxMon, which may be the mon it was loaded from.
+void StoreBoxMonView(struct BoxMonView *view, struct BoxPokemon *boxMon)
+{
+    *boxMon = view->boxMon;
+    if (view->isSecureModified)
+        boxMon->checksum = CalculateBoxMonChecksum(boxMon);
+    EncryptBoxMon(boxMon);
+}
+
 void CopyMon(void *dest, void *src, size_t size)
 {
     memcpy(dest, src, size);
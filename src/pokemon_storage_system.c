@@ -4440,6 +4440,7 @@ static void InitBoxMonSprites(u8 boxId)
     u16 i, j, count;
     u16 species;
     u32 personality;
+    struct BoxMonView view;
 
     count = 0;
     boxPosition = 0;
@@ -4449,11 +4450,16 @@ static void InitBoxMonSprites(u8 boxId)
     {
         for (j = 0; j < IN_BOX_COLUMNS; j++)
         {
-            species = GetBoxMonDataAt(boxId, boxPosition, MON_DATA_SPECIES_OR_EGG);
+            LoadBoxMonView(&view, GetBoxedMonPtr(boxId, boxPosition));
+            species = GetBoxMonViewData(&view, MON_DATA_SPECIES_OR_EGG);
             if (species != SPECIES_NONE)
             {
-                personality = GetBoxMonDataAt(boxId, boxPosition, MON_DATA_PERSONALITY);
+                personality = GetBoxMonViewData(&view, MON_DATA_PERSONALITY);
                 sStorage->boxMonsSprites[count] = CreateMonIconSprite(species, personality, 8 * (3 * j) + 100, 8 * (3 * i) + 44, 2, 19 - j);
+
+                // If in item mode, set all Pokémon icons with no item to be transparent
+                if (sStorage->boxOption == OPTION_MOVE_ITEMS && GetBoxMonViewData(&view, MON_DATA_HELD_ITEM) == ITEM_NONE)
+                    sStorage->boxMonsSprites[count]->oam.objMode = ST_OAM_OBJ_BLEND;
             }
             else
             {
@@ -4463,16 +4469,6 @@ static void InitBoxMonSprites(u8 boxId)
             count++;
         }
     }
-
-    // If in item mode, set all Pokémon icons with no item to be transparent
-    if (sStorage->boxOption == OPTION_MOVE_ITEMS)
-    {
-        for (boxPosition = 0; boxPosition < IN_BOX_COUNT; boxPosition++)
-        {
-            if (GetBoxMonDataAt(boxId, boxPosition, MON_DATA_HELD_ITEM) == ITEM_NONE)
-                sStorage->boxMonsSprites[boxPosition]->oam.objMode = ST_OAM_OBJ_BLEND;
-        }
-    }
 }
 
 static void CreateBoxMonIconAtPos(u8 boxPosition)
@@ -5201,7 +5197,7 @@ static void Task_InitBox(u8 taskId)
     case 0:
         sStorage->wallpaperOffset = 0;
         sStorage->bg2_X = 0;
-        task->tDmaIdx = RequestDma3Fill(0, sStorage->wallpaperBgTilemapBuffer, sizeof(sStorage->wallpaperBgTilemapBuffer), 1);
+        task->tDmaIdx = RequestDma3FillWithPriority(0, sStorage->wallpaperBgTilemapBuffer, sizeof(sStorage->wallpaperBgTilemapBuffer), 1, DMA3_PRIORITY_LOW);
         break;
     case 1:
         if (CheckForSpaceForDma3Request(task->tDmaIdx) == -1)
@@ -6885,27 +6881,28 @@ static void SetDisplayMonData(void *pokemon, u8 mode)
     }
     else if (mode == MODE_BOX)
     {
-        struct BoxPokemon *boxMon = (struct BoxPokemon *)pokemon;
+        struct BoxMonView view;
 
-        sStorage->displayMonSpecies = GetBoxMonData(pokemon, MON_DATA_SPECIES_OR_EGG);
+        LoadBoxMonView(&view, (struct BoxPokemon *)pokemon);
+        sStorage->displayMonSpecies = GetBoxMonViewData(&view, MON_DATA_SPECIES_OR_EGG);
         if (sStorage->displayMonSpecies != SPECIES_NONE)
         {
-            u32 otId = GetBoxMonData(boxMon, MON_DATA_OT_ID);
-            sanityIsBadEgg = GetBoxMonData(boxMon, MON_DATA_SANITY_IS_BAD_EGG);
+            u32 otId = GetBoxMonViewData(&view, MON_DATA_OT_ID);
+            sanityIsBadEgg = GetBoxMonViewData(&view, MON_DATA_SANITY_IS_BAD_EGG);
             if (sanityIsBadEgg)
                 sStorage->displayMonIsEgg = TRUE;
             else
-                sStorage->displayMonIsEgg = GetBoxMonData(boxMon, MON_DATA_IS_EGG);
+                sStorage->displayMonIsEgg = GetBoxMonViewData(&view, MON_DATA_IS_EGG);
 
 
-            GetBoxMonData(boxMon, MON_DATA_NICKNAME, sStorage->displayMonName);
+            GetBoxMonViewData(&view, MON_DATA_NICKNAME, sStorage->displayMonName);
             StringGet_Nickname(sStorage->displayMonName);
-            sStorage->displayMonLevel = GetLevelFromBoxMonExp(boxMon);
-            sStorage->displayMonMarkings = GetBoxMonData(boxMon, MON_DATA_MARKINGS);
-            sStorage->displayMonPersonality = GetBoxMonData(boxMon, MON_DATA_PERSONALITY);
+            sStorage->displayMonLevel = GetLevelFromBoxMonViewExp(&view);
+            sStorage->displayMonMarkings = GetBoxMonViewData(&view, MON_DATA_MARKINGS);
+            sStorage->displayMonPersonality = GetBoxMonViewData(&view, MON_DATA_PERSONALITY);
             sStorage->displayMonPalette = GetMonSpritePalFromSpeciesAndPersonality(sStorage->displayMonSpecies, otId, sStorage->displayMonPersonality);
             gender = GetGenderFromSpeciesAndPersonality(sStorage->displayMonSpecies, sStorage->displayMonPersonality);
-            sStorage->displayMonItemId = GetBoxMonData(boxMon, MON_DATA_HELD_ITEM);
+            sStorage->displayMonItemId = GetBoxMonViewData(&view, MON_DATA_HELD_ITEM);
         }
     }
     else
@@ -9544,6 +9541,7 @@ s16 AdvanceStorageMonIndex(struct BoxPokemon *boxMons, u8 currIndex, u8 maxIndex
 {
     s16 i;
     s16 direction = -1;
+    struct BoxMonView view;
 
     if (mode == 0 || mode == 1)
         direction = 1;
@@ -9560,8 +9558,9 @@ s16 AdvanceStorageMonIndex(struct BoxPokemon *boxMons, u8 currIndex, u8 maxIndex
     {
         for (i = (s8)currIndex + direction; i >= 0 && i <= maxIndex; i += direction)
         {
-            if (GetBoxMonData(&boxMons[i], MON_DATA_SPECIES) != SPECIES_NONE
-                && !GetBoxMonData(&boxMons[i], MON_DATA_IS_EGG))
+            LoadBoxMonView(&view, &boxMons[i]);
+            if (GetBoxMonViewData(&view, MON_DATA_SPECIES) != SPECIES_NONE
+                && !GetBoxMonViewData(&view, MON_DATA_IS_EGG))
                 return i;
         }
     }
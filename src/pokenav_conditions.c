@@ -46,6 +46,7 @@ static u8 SwitchConditionSummaryIndex(bool8);
 static void CopyMonNameGenderLocation(s16, u8);
 static void GetMonConditionGraphData(s16, u8);
 static void ConditionGraphDrawMonPic(s16, u8);
+static struct BoxPokemon *GetConditionListBoxMon(u16 boxId, u16 monId);
 
 bool32 PokenavCallback_Init_ConditionGraph_Party(void)
 {
@@ -335,7 +336,7 @@ u8 *CopyStringLeftAlignedToConditionData(u8 *dst, const u8 *src, s16 n)
 static u8 *CopyConditionMonNameGender(u8 *str, u16 listId, bool8 skipPadding)
 {
     u16 boxId, monId, gender, species, level, lvlDigits;
-    struct BoxPokemon *boxMon;
+    struct BoxMonView view;
     u8 *txtPtr, *str_;
     struct PokenavMonList *monListPtr = GetSubstructPtr(POKENAV_SUBSTRUCT_MON_LIST);
 
@@ -347,23 +348,18 @@ static u8 *CopyConditionMonNameGender(u8 *str, u16 listId, bool8 skipPadding)
     *(str++) = TEXT_COLOR_TRANSPARENT;
     *(str++) = TEXT_COLOR_LIGHT_BLUE;
 
-    if (GetBoxOrPartyMonData(boxId, monId, MON_DATA_IS_EGG, NULL))
+    LoadBoxMonView(&view, GetConditionListBoxMon(boxId, monId));
+    if (GetBoxMonViewData(&view, MON_DATA_IS_EGG))
         return StringCopyPadded(str, gText_EggNickname, CHAR_SPACE, POKEMON_NAME_LENGTH + 2);
 
-    GetBoxOrPartyMonData(boxId, monId, MON_DATA_NICKNAME, str);
+    GetBoxMonViewData(&view, MON_DATA_NICKNAME, str);
     StringGet_Nickname(str);
-    species = GetBoxOrPartyMonData(boxId, monId, MON_DATA_SPECIES, NULL);
+    species = GetBoxMonViewData(&view, MON_DATA_SPECIES);
+    gender = GetGenderFromSpeciesAndPersonality(species, GetBoxMonViewData(&view, MON_DATA_PERSONALITY));
     if (boxId == TOTAL_BOXES_COUNT)
-    {
         level = GetMonData(&gPlayerParty[monId], MON_DATA_LEVEL);
-        gender = GetMonGender(&gPlayerParty[monId]);
-    }
     else
-    {
-        boxMon = GetBoxedMonPtr(boxId, monId);
-        gender = GetBoxMonGender(boxMon);
-        level = GetLevelFromBoxMonExp(boxMon);
-    }
+        level = GetLevelFromBoxMonViewExp(&view);
 
     if ((species == SPECIES_NIDORAN_F || species == SPECIES_NIDORAN_M) && !StringCompare(str, gSpeciesNames[species]))
         gender = MON_GENDERLESS;
@@ -491,6 +487,7 @@ static void InitSearchResultsConditionList(void)
 static void GetMonConditionGraphData(s16 listId, u8 loadId)
 {
     u16 boxId, monId, i;
+    struct BoxMonView view;
     struct Pokenav_ConditionMenu *menu = GetSubstructPtr(POKENAV_SUBSTRUCT_CONDITION_GRAPH_MENU);
     struct PokenavMonList *monListPtr = GetSubstructPtr(POKENAV_SUBSTRUCT_MON_LIST);
 
@@ -498,13 +495,14 @@ static void GetMonConditionGraphData(s16 listId, u8 loadId)
     {
         boxId = monListPtr->monData[listId].boxId;
         monId = monListPtr->monData[listId].monId;
-        menu->graph.conditions[loadId][CONDITION_COOL] = GetBoxOrPartyMonData(boxId, monId, MON_DATA_COOL, NULL);
-        menu->graph.conditions[loadId][CONDITION_TOUGH] = GetBoxOrPartyMonData(boxId, monId, MON_DATA_TOUGH, NULL);
-        menu->graph.conditions[loadId][CONDITION_SMART] = GetBoxOrPartyMonData(boxId, monId, MON_DATA_SMART, NULL);
-        menu->graph.conditions[loadId][CONDITION_CUTE] = GetBoxOrPartyMonData(boxId, monId, MON_DATA_CUTE, NULL);
-        menu->graph.conditions[loadId][CONDITION_BEAUTY] = GetBoxOrPartyMonData(boxId, monId, MON_DATA_BEAUTY, NULL);
-        menu->numSparkles[loadId] = GET_NUM_CONDITION_SPARKLES(GetBoxOrPartyMonData(boxId, monId, MON_DATA_SHEEN, NULL));
-        menu->monMarks[loadId] = GetBoxOrPartyMonData(boxId, monId, MON_DATA_MARKINGS, NULL);
+        LoadBoxMonView(&view, GetConditionListBoxMon(boxId, monId));
+        menu->graph.conditions[loadId][CONDITION_COOL] = GetBoxMonViewData(&view, MON_DATA_COOL);
+        menu->graph.conditions[loadId][CONDITION_TOUGH] = GetBoxMonViewData(&view, MON_DATA_TOUGH);
+        menu->graph.conditions[loadId][CONDITION_SMART] = GetBoxMonViewData(&view, MON_DATA_SMART);
+        menu->graph.conditions[loadId][CONDITION_CUTE] = GetBoxMonViewData(&view, MON_DATA_CUTE);
+        menu->graph.conditions[loadId][CONDITION_BEAUTY] = GetBoxMonViewData(&view, MON_DATA_BEAUTY);
+        menu->numSparkles[loadId] = GET_NUM_CONDITION_SPARKLES(GetBoxMonViewData(&view, MON_DATA_SHEEN));
+        menu->monMarks[loadId] = GetBoxMonViewData(&view, MON_DATA_MARKINGS);
         ConditionGraph_CalcPositions(menu->graph.conditions[loadId], menu->graph.savedPositions[loadId]);
     }
     else
@@ -538,6 +536,16 @@ static void ConditionGraphDrawMonPic(s16 listId, u8 loadId)
     LZ77UnCompWram(GetMonSpritePalFromSpeciesAndPersonality(species, tid, personality), menu->monPal[loadId]);
 }
 
+// Every condition list entry is a box mon or a party mon, and all of the
+// fields read here are stored in the BoxPokemon.
+static struct BoxPokemon *GetConditionListBoxMon(u16 boxId, u16 monId)
+{
+    if (boxId == TOTAL_BOXES_COUNT)
+        return &gPlayerParty[monId].box;
+    else
+        return GetBoxedMonPtr(boxId, monId);
+}
+
 u16 GetMonListCount(void)
 {
     struct PokenavMonList *monListPtr = GetSubstructPtr(POKENAV_SUBSTRUCT_MON_LIST);
@@ -469,6 +469,7 @@ void Pokenav_AllocAndLoadPalettes(const struct SpritePalette *palettes)
 void PokenavFillPalette(u32 palIndex, u16 fillValue)
 {
     CpuFill16(fillValue, &gPlttBufferFaded[OBJ_PLTT_ID(palIndex)], PLTT_SIZE_4BPP);
+    MarkPlttBufferDirty(OBJ_PLTT_ID(palIndex), PLTT_SIZE_4BPP);
 }
 
 void PokenavCopyPalette(const u16 *src, const u16 *dest, int size, int a3, int a4, u16 *palette)
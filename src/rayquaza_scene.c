@@ -1362,6 +1362,7 @@ static void SetWindowsHideVertBorders(void)
     SetGpuReg(REG_OFFSET_WIN0V, WIN_RANGE(24, DISPLAY_HEIGHT - 24));
     gPlttBufferUnfaded[0] = 0;
     gPlttBufferFaded[0] = 0;
+    MarkPlttBufferDirty(0, PLTT_SIZEOF(1));
 }
 
 static void ResetWindowDimensions(void)
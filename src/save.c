@@ -13,6 +13,7 @@
 #include "constants/game_stat.h"
 
 static u16 CalculateChecksum(void *, u16);
+static bool8 IsNewerSaveCounter(u32, u32);
 static bool8 ReadFlashSector(u8, struct SaveSector *);
 static u8 GetSaveValidStatus(const struct SaveSectorLocation *);
 static u8 CopySaveSlotData(u16, struct SaveSectorLocation *);
@@ -35,8 +36,11 @@ static u8 HandleReplaceSector(u16, const struct SaveSectorLocation *);
  * them each time the game is saved, so that if the current save slot is corrupt,
  * we can load the previous one. We also rotate the sectors in each save slot
  * so that the same data is not always being written to the same sector. This
- * might be done to reduce wear on the flash memory, but I'm not sure, since all
- * 14 sectors get written anyway.
+ * might be done to reduce wear on the flash memory.
+ *
+ * Normal saves only write the sectors that changed since the slot was last
+ * written (see WriteChangedSaveSectors), so they keep the slot's rotation.
+ * Link saves still write every sector and rotate.
  *
  * See SECTOR_ID_* constants in save.h
  */
@@ -77,6 +81,7 @@ struct
 STATIC_ASSERT(sizeof(struct SaveBlock2) <= SECTOR_DATA_SIZE, SaveBlock2FreeSpace);
 STATIC_ASSERT(sizeof(struct SaveBlock1) <= SECTOR_DATA_SIZE * (SECTOR_ID_SAVEBLOCK1_END - SECTOR_ID_SAVEBLOCK1_START + 1), SaveBlock1FreeSpace);
 STATIC_ASSERT(sizeof(struct PokemonStorage) <= SECTOR_DATA_SIZE * (SECTOR_ID_PKMN_STORAGE_END - SECTOR_ID_PKMN_STORAGE_START + 1), PokemonStorageFreeSpace);
+STATIC_ASSERT(SECTOR_FOOTER_OFFSET + sizeof(struct SaveSectorFooter) == SECTOR_SIZE, SaveSectorFooterSize);
 
 COMMON_DATA u16 gLastWrittenSector = 0;
 COMMON_DATA u32 gLastSaveCounter = 0;
@@ -135,6 +140,106 @@ static bool32 SetDamagedSectorBits(u8 op, u8 sectorId)
     return retVal;
 }
 
+// Find which sector of a save slot holds SaveBlock2, i.e. how far the slot's
+// sectors are rotated. Only the footers are read.
+static bool8 GetSaveSlotRotation(u8 slot, u16 *rotation)
+{
+    u16 i;
+    struct SaveSectorFooter footer;
+
+    for (i = 0; i < NUM_SECTORS_PER_SLOT; i++)
+    {
+        ReadFlash(i + NUM_SECTORS_PER_SLOT * slot, SECTOR_FOOTER_OFFSET, (u8 *)&footer, sizeof(footer));
+        if (footer.signature == SECTOR_SIGNATURE && footer.id == SECTOR_ID_SAVEBLOCK2)
+        {
+            *rotation = i;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+// Whether the sector in the slot being written already holds this data. The
+// checksum in the footer rules out most changed sectors without reading the
+// data, but it's only a sum, so a sector with a matching checksum is compared
+// in full (e.g. swapping two Pokémon in a box doesn't change the checksum).
+static bool8 IsSaveSectorUnchanged(u16 sectorId, const struct SaveSectorLocation *locations)
+{
+    u16 i;
+    u16 sector;
+    u8 *data;
+    u16 size;
+    struct SaveSectorFooter footer;
+
+    // Adjust sector id for current save slot
+    sector = sectorId + gLastWrittenSector;
+    sector %= NUM_SECTORS_PER_SLOT;
+    sector += NUM_SECTORS_PER_SLOT * (gSaveCounter % NUM_SAVE_SLOTS);
+
+    data = locations[sectorId].data;
+    size = locations[sectorId].size;
+
+    ReadFlash(sector, SECTOR_FOOTER_OFFSET, (u8 *)&footer, sizeof(footer));
+    if (footer.signature != SECTOR_SIGNATURE
+     || footer.id != sectorId
+     || footer.checksum != CalculateChecksum(data, size))
+        return FALSE;
+
+    ReadFlashSector(sector, gReadWriteSector);
+    for (i = 0; i < size; i++)
+    {
+        if (gReadWriteSector->data[i] != data[i])
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Writes the save slot like WriteSaveSectorOrSlot(FULL_SAVE_SLOT, ...), but
+// skips the sectors that the slot being written already holds. Most saves
+// only change SaveBlock1 and SaveBlock2, so the PC sectors are rarely written.
+//
+// The slot being written is the older of the two, so the newer one is still
+// there to load if this save is interrupted. The SaveBlock2 sector is written
+// last and is what GetSaveValidStatus takes the slot's counter from; if any
+// other sector in the slot is newer than it, the save didn't finish.
+static u8 WriteChangedSaveSectors(const struct SaveSectorLocation *locations)
+{
+    u32 status;
+    u16 i;
+    u16 rotation;
+
+    gReadWriteSector = &gSaveDataBuffer;
+    gLastKnownGoodSector = gLastWrittenSector; // backup the current written sector before attempting to write.
+    gLastSaveCounter = gSaveCounter;
+    gSaveCounter++;
+    status = SAVE_STATUS_OK;
+
+    // Sectors can only be kept if they stay where they are, so rather than
+    // rotating to the next sector, keep the rotation the slot already has.
+    if (!GetSaveSlotRotation(gSaveCounter % NUM_SAVE_SLOTS, &rotation))
+        rotation = (gLastWrittenSector + 1) % NUM_SECTORS_PER_SLOT;
+    gLastWrittenSector = rotation;
+
+    for (i = SECTOR_ID_SAVEBLOCK2 + 1; i < NUM_SECTORS_PER_SLOT; i++)
+    {
+        if (!IsSaveSectorUnchanged(i, locations))
+            HandleWriteSector(i, locations);
+    }
+    HandleWriteSector(SECTOR_ID_SAVEBLOCK2, locations);
+
+    if (gDamagedSaveSectors)
+    {
+        // At least one sector save failed
+        status = SAVE_STATUS_ERROR;
+        gLastWrittenSector = gLastKnownGoodSector;
+        gSaveCounter = gLastSaveCounter;
+    }
+
+    return status;
+}
+
 static u8 WriteSaveSectorOrSlot(u16 sectorId, const struct SaveSectorLocation *locations)
 {
     u32 status;
@@ -517,6 +622,7 @@ static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations)
     u16 checksum;
     u32 saveSlot1Counter = 0;
     u32 saveSlot2Counter = 0;
+    u32 newestSectorCounter = 0;
     u32 validSectorFlags = 0;
     bool8 signatureValid = FALSE;
     u8 saveSlot1Status;
@@ -532,7 +638,10 @@ static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations)
             checksum = CalculateChecksum(gReadWriteSector->data, locations[gReadWriteSector->id].size);
             if (gReadWriteSector->checksum == checksum)
             {
-                saveSlot1Counter = gReadWriteSector->counter;
+                if (gReadWriteSector->id == SECTOR_ID_SAVEBLOCK2)
+                    saveSlot1Counter = gReadWriteSector->counter;
+                if (validSectorFlags == 0 || IsNewerSaveCounter(gReadWriteSector->counter, newestSectorCounter))
+                    newestSectorCounter = gReadWriteSector->counter;
                 validSectorFlags |= 1 << gReadWriteSector->id;
             }
         }
@@ -540,7 +649,8 @@ static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations)
 
     if (signatureValid)
     {
-        if (validSectorFlags == (1 << NUM_SECTORS_PER_SLOT) - 1)
+        // A sector newer than SaveBlock2 means WriteChangedSaveSectors was interrupted
+        if (validSectorFlags == (1 << NUM_SECTORS_PER_SLOT) - 1 && newestSectorCounter == saveSlot1Counter)
             saveSlot1Status = SAVE_STATUS_OK;
         else
             saveSlot1Status = SAVE_STATUS_ERROR;
@@ -564,7 +674,10 @@ static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations)
             checksum = CalculateChecksum(gReadWriteSector->data, locations[gReadWriteSector->id].size);
             if (gReadWriteSector->checksum == checksum)
             {
-                saveSlot2Counter = gReadWriteSector->counter;
+                if (gReadWriteSector->id == SECTOR_ID_SAVEBLOCK2)
+                    saveSlot2Counter = gReadWriteSector->counter;
+                if (validSectorFlags == 0 || IsNewerSaveCounter(gReadWriteSector->counter, newestSectorCounter))
+                    newestSectorCounter = gReadWriteSector->counter;
                 validSectorFlags |= 1 << gReadWriteSector->id;
             }
         }
@@ -572,7 +685,8 @@ static u8 GetSaveValidStatus(const struct SaveSectorLocation *locations)
 
     if (signatureValid)
     {
-        if (validSectorFlags == (1 << NUM_SECTORS_PER_SLOT) - 1)
+        // A sector newer than SaveBlock2 means WriteChangedSaveSectors was interrupted
+        if (validSectorFlags == (1 << NUM_SECTORS_PER_SLOT) - 1 && newestSectorCounter == saveSlot2Counter)
             saveSlot2Status = SAVE_STATUS_OK;
         else
             saveSlot2Status = SAVE_STATUS_ERROR;
@@ -671,6 +785,12 @@ static bool8 ReadFlashSector(u8 sectorId, struct SaveSector *sector)
     return TRUE;
 }
 
+// Save counters can wrap around, see GetSaveValidStatus
+static bool8 IsNewerSaveCounter(u32 counter, u32 than)
+{
+    return (s32)(counter - than) > 0;
+}
+
 static u16 CalculateChecksum(void *data, u16 size)
 {
     u16 i;
@@ -736,7 +856,7 @@ u8 HandleSavingData(u8 saveType)
     case SAVE_NORMAL:
     default:
         CopyPartyAndObjectsToSave();
-        WriteSaveSectorOrSlot(FULL_SAVE_SLOT, gRamSaveSectorLocations);
+        WriteChangedSaveSectors(gRamSaveSectorLocations);
         break;
     case SAVE_LINK:
     case SAVE_EREADER: // Dummied, now duplicate of SAVE_LINK
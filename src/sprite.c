@@ -2,9 +2,13 @@
 #include "sprite.h"
 #include "main.h"
 #include "palette.h"
+#include "frame_profiler.h"
 
 #define MAX_SPRITE_COPY_REQUESTS 64
 
+// Adjusted Y in a sort key ranges from -127 to DISPLAY_HEIGHT - 1
+#define SPRITE_SORT_KEY_Y_BITS 9
+
 #define sAnchorX data[6]
 #define sAnchorY data[7]
 
@@ -278,7 +282,7 @@ COMMON_DATA u32 gOamMatrixAllocBitmap = 0;
 COMMON_DATA u8 gReservedSpritePaletteCount = 0;
 
 EWRAM_DATA struct Sprite gSprites[MAX_SPRITES + 1] = {0};
-EWRAM_DATA static u16 sSpritePriorities[MAX_SPRITES] = {0};
+EWRAM_DATA static u32 sSpriteSortKeys[MAX_SPRITES] = {0};
 EWRAM_DATA static u8 sSpriteOrder[MAX_SPRITES] = {0};
 EWRAM_DATA static bool8 sShouldProcessSpriteCopyRequests = 0;
 EWRAM_DATA static u8 sSpriteCopyRequestCount = 0;
@@ -314,7 +318,7 @@ void AnimateSprites(void)
 
         if (sprite->inUse)
         {
-            sprite->callback(sprite);
+            PROFILE_CALL(PROFILE_SPRITE_CALLBACK, sprite->callback, sprite->callback(sprite));
 
             if (sprite->inUse)
                 AnimateSprite(sprite);
@@ -358,6 +362,9 @@ void UpdateOamCoords(void)
     }
 }
 
+// Packs each sprite's sort order into a single key: priority, then
+// subpriority, then Y from bottom to top. Y is adjusted so that sprites
+// wrapped around the top of the screen sort above the ones at the top.
 void BuildSpritePriorities(void)
 {
     u16 i;
@@ -365,104 +372,57 @@ void BuildSpritePriorities(void)
     {
         struct Sprite *sprite = &gSprites[i];
         u16 priority = sprite->subpriority | (sprite->oam.priority << 8);
-        sSpritePriorities[i] = priority;
-    }
-}
+        s16 y = sprite->oam.y;
 
-void SortSprites(void)
-{
-    u8 i;
-    for (i = 1; i < MAX_SPRITES; i++)
-    {
-        u8 j = i;
-        struct Sprite *sprite1 = &gSprites[sSpriteOrder[i - 1]];
-        struct Sprite *sprite2 = &gSprites[sSpriteOrder[i]];
-        u16 sprite1Priority = sSpritePriorities[sSpriteOrder[i - 1]];
-        u16 sprite2Priority = sSpritePriorities[sSpriteOrder[i]];
-        s16 sprite1Y = sprite1->oam.y;
-        s16 sprite2Y = sprite2->oam.y;
-
-        if (sprite1Y >= DISPLAY_HEIGHT)
-            sprite1Y = sprite1Y - 256;
-
-        if (sprite2Y >= DISPLAY_HEIGHT)
-            sprite2Y = sprite2Y - 256;
-
-        if (sprite1->oam.affineMode == ST_OAM_AFFINE_DOUBLE
-         && sprite1->oam.size == ST_OAM_SIZE_3)
-        {
-            u32 shape = sprite1->oam.shape;
-            if (shape == ST_OAM_SQUARE || shape == ST_OAM_V_RECTANGLE)
-            {
-                if (sprite1Y > 128)
-                    sprite1Y = sprite1Y - 256;
-            }
-        }
+        if (y >= DISPLAY_HEIGHT)
+            y = y - 256;
 
-        if (sprite2->oam.affineMode == ST_OAM_AFFINE_DOUBLE
-         && sprite2->oam.size == ST_OAM_SIZE_3)
+        if (sprite->oam.affineMode == ST_OAM_AFFINE_DOUBLE
+         && sprite->oam.size == ST_OAM_SIZE_3)
         {
-            u32 shape = sprite2->oam.shape;
+            u32 shape = sprite->oam.shape;
             if (shape == ST_OAM_SQUARE || shape == ST_OAM_V_RECTANGLE)
             {
-                if (sprite2Y > 128)
-                    sprite2Y = sprite2Y - 256;
+                if (y > 128)
+                    y = y - 256;
             }
         }
 
-        while (j > 0
-            && ((sprite1Priority > sprite2Priority)
-             || (sprite1Priority == sprite2Priority && sprite1Y < sprite2Y)))
-        {
-            u8 temp = sSpriteOrder[j];
-            sSpriteOrder[j] = sSpriteOrder[j - 1];
-            sSpriteOrder[j - 1] = temp;
+        sSpriteSortKeys[i] = (priority << SPRITE_SORT_KEY_Y_BITS) | (DISPLAY_HEIGHT - 1 - y);
+    }
+}
 
-            // UB: If j equals 1, then j-- makes j equal 0.
-            // Then, sSpriteOrder[-1] gets accessed below.
-            // Although this doesn't result in a bug in the ROM,
-            // the behavior is undefined.
-            j--;
-#ifdef UBFIX
-            if (j == 0)
-                break;
-#endif
+// Insertion sort starting from last frame's order. Sprites rarely change
+// order between frames, so this is usually a single pass over the keys.
+// Sprites with equal keys keep their previous order.
+void SortSprites(void)
+{
+    u32 keys[MAX_SPRITES];
+    u8 i;
 
-            sprite1 = &gSprites[sSpriteOrder[j - 1]];
-            sprite2 = &gSprites[sSpriteOrder[j]];
-            sprite1Priority = sSpritePriorities[sSpriteOrder[j - 1]];
-            sprite2Priority = sSpritePriorities[sSpriteOrder[j]];
-            sprite1Y = sprite1->oam.y;
-            sprite2Y = sprite2->oam.y;
+    for (i = 0; i < MAX_SPRITES; i++)
+        keys[i] = sSpriteSortKeys[sSpriteOrder[i]];
 
-            if (sprite1Y >= DISPLAY_HEIGHT)
-                sprite1Y = sprite1Y - 256;
+    for (i = 1; i < MAX_SPRITES; i++)
+    {
+        u32 key = keys[i];
+        u8 spriteId;
+        u8 j;
 
-            if (sprite2Y >= DISPLAY_HEIGHT)
-                sprite2Y = sprite2Y - 256;
+        if (keys[i - 1] <= key)
+            continue;
 
-            if (sprite1->oam.affineMode == ST_OAM_AFFINE_DOUBLE
-             && sprite1->oam.size == ST_OAM_SIZE_3)
-            {
-                u32 shape = sprite1->oam.shape;
-                if (shape == ST_OAM_SQUARE || shape == ST_OAM_V_RECTANGLE)
-                {
-                    if (sprite1Y > 128)
-                        sprite1Y = sprite1Y - 256;
-                }
-            }
+        spriteId = sSpriteOrder[i];
+        j = i;
+        do
+        {
+            keys[j] = keys[j - 1];
+            sSpriteOrder[j] = sSpriteOrder[j - 1];
+            j--;
+        } while (j > 0 && keys[j - 1] > key);
 
-            if (sprite2->oam.affineMode == ST_OAM_AFFINE_DOUBLE
-             && sprite2->oam.size == ST_OAM_SIZE_3)
-            {
-                u32 shape = sprite2->oam.shape;
-                if (shape == ST_OAM_SQUARE || shape == ST_OAM_V_RECTANGLE)
-                {
-                    if (sprite2Y > 128)
-                        sprite2Y = sprite2Y - 256;
-                }
-            }
-        }
+        keys[j] = key;
+        sSpriteOrder[j] = spriteId;
     }
 }
 
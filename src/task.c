@@ -1,10 +1,30 @@
 #include "global.h"
 #include "task.h"
+#include "frame_profiler.h"
+
+// Task IDs are u8s, and the two highest values are the list sentinels.
+STATIC_ASSERT(NUM_TASKS < HEAD_SENTINEL, NumTasksTooLarge)
+
+#define NUM_TASK_PRIORITIES 0x100
+#define BITMAP_WORDS(n) (((n) + 31) / 32)
 
 COMMON_DATA struct Task gTasks[NUM_TASKS] = {0};
 
+// Active tasks are linked in priority order, with tasks of equal priority in the
+// order they were created. Rather than walking the list to find where a new task
+// goes, the last task of each priority in use is remembered, along with a bitmap
+// of the priorities in use, so the only search is over that bitmap.
+static u8 sFirstTaskId;
+static u8 sTaskCount;
+static u32 sActiveTaskBits[BITMAP_WORDS(NUM_TASKS)];
+static u32 sUsedPriorityBits[BITMAP_WORDS(NUM_TASK_PRIORITIES)];
+static u8 sLastTaskIdByPriority[NUM_TASK_PRIORITIES];
+static u8 sTaskFrameSkips[NUM_TASKS];
+static u8 sTaskFramesUntilRun[NUM_TASKS];
+
 static void InsertTask(u8 newTaskId);
-static u8 FindFirstActiveTask(void);
+static u8 FindFreeTaskId(void);
+static u8 FindLastTaskIdUpToPriority(u8 priority);
 
 void ResetTasks(void)
 {
@@ -18,77 +38,137 @@ void ResetTasks(void)
         gTasks[i].next = i + 1;
         gTasks[i].priority = -1;
         memset(gTasks[i].data, 0, sizeof(gTasks[i].data));
+        sTaskFrameSkips[i] = 0;
+        sTaskFramesUntilRun[i] = 0;
     }
 
     gTasks[0].prev = HEAD_SENTINEL;
     gTasks[NUM_TASKS - 1].next = TAIL_SENTINEL;
+
+    sFirstTaskId = TAIL_SENTINEL;
+    sTaskCount = 0;
+    memset(sActiveTaskBits, 0, sizeof(sActiveTaskBits));
+    memset(sUsedPriorityBits, 0, sizeof(sUsedPriorityBits));
 }
 
 u8 CreateTask(TaskFunc func, u8 priority)
 {
-    u8 i;
+    u8 i = FindFreeTaskId();
 
-    for (i = 0; i < NUM_TASKS; i++)
+    if (i != NUM_TASKS)
+    {
+        gTasks[i].func = func;
+        gTasks[i].priority = priority;
+        InsertTask(i);
+        memset(gTasks[i].data, 0, sizeof(gTasks[i].data));
+        sTaskFrameSkips[i] = 0;
+        sTaskFramesUntilRun[i] = 0;
+        gTasks[i].isActive = TRUE;
+        return i;
+    }
+
+    return 0;
+}
+
+static u8 FindFreeTaskId(void)
+{
+    u32 i, taskId, freeBits;
+
+    for (i = 0; i < ARRAY_COUNT(sActiveTaskBits); i++)
     {
-        if (!gTasks[i].isActive)
+        freeBits = ~sActiveTaskBits[i];
+        if (freeBits != 0)
         {
-            gTasks[i].func = func;
-            gTasks[i].priority = priority;
-            InsertTask(i);
-            memset(gTasks[i].data, 0, sizeof(gTasks[i].data));
-            gTasks[i].isActive = TRUE;
-            return i;
+            for (taskId = i * 32; !(freeBits & 1); taskId++)
+                freeBits >>= 1;
+            if (taskId < NUM_TASKS)
+                return taskId;
         }
     }
 
-    return 0;
+    return NUM_TASKS;
+}
+
+// Returns the task that a new task of this priority should follow, or
+// HEAD_SENTINEL if it should go first.
+static u8 FindLastTaskIdUpToPriority(u8 priority)
+{
+    s32 i = priority / 32;
+    u32 bit = priority % 32;
+    u32 usedBits = sUsedPriorityBits[i] & ((2u << bit) - 1);
+
+    while (usedBits == 0)
+    {
+        if (--i < 0)
+            return HEAD_SENTINEL;
+        usedBits = sUsedPriorityBits[i];
+        bit = 31;
+    }
+
+    while (!(usedBits & (1u << bit)))
+        bit--;
+
+    return sLastTaskIdByPriority[i * 32 + bit];
 }
 
 static void InsertTask(u8 newTaskId)
 {
-    u8 taskId = FindFirstActiveTask();
+    u8 priority = gTasks[newTaskId].priority;
+    u8 taskId = FindLastTaskIdUpToPriority(priority);
 
-    if (taskId == NUM_TASKS)
+    if (sTaskCount == 0)
     {
         // The new task is the only task.
         gTasks[newTaskId].prev = HEAD_SENTINEL;
         gTasks[newTaskId].next = TAIL_SENTINEL;
-        return;
+        sFirstTaskId = newTaskId;
     }
-
-    while (1)
+    else if (taskId == HEAD_SENTINEL)
     {
-        if (gTasks[newTaskId].priority < gTasks[taskId].priority)
-        {
-            // We've found a task with a higher priority value,
-            // so we insert the new task before it.
-            gTasks[newTaskId].prev = gTasks[taskId].prev;
-            gTasks[newTaskId].next = taskId;
-            if (gTasks[taskId].prev != HEAD_SENTINEL)
-                gTasks[gTasks[taskId].prev].next = newTaskId;
-            gTasks[taskId].prev = newTaskId;
-            return;
-        }
-        if (gTasks[taskId].next == TAIL_SENTINEL)
-        {
-            // We've reached the end.
-            gTasks[newTaskId].prev = taskId;
-            gTasks[newTaskId].next = gTasks[taskId].next;
-            gTasks[taskId].next = newTaskId;
-            return;
-        }
-        taskId = gTasks[taskId].next;
+        // Every task has a higher priority value, so the new task goes first.
+        gTasks[newTaskId].prev = HEAD_SENTINEL;
+        gTasks[newTaskId].next = sFirstTaskId;
+        gTasks[sFirstTaskId].prev = newTaskId;
+        sFirstTaskId = newTaskId;
+    }
+    else
+    {
+        // Insert the new task after the last task with the same or a lower priority value.
+        gTasks[newTaskId].prev = taskId;
+        gTasks[newTaskId].next = gTasks[taskId].next;
+        if (gTasks[taskId].next != TAIL_SENTINEL)
+            gTasks[gTasks[taskId].next].prev = newTaskId;
+        gTasks[taskId].next = newTaskId;
     }
+
+    sLastTaskIdByPriority[priority] = newTaskId;
+    sUsedPriorityBits[priority / 32] |= 1u << (priority % 32);
+    sActiveTaskBits[newTaskId / 32] |= 1u << (newTaskId % 32);
+    sTaskCount++;
 }
 
 void DestroyTask(u8 taskId)
 {
+    u8 priority;
+
     if (gTasks[taskId].isActive)
     {
         gTasks[taskId].isActive = FALSE;
 
+        priority = gTasks[taskId].priority;
+        if (sLastTaskIdByPriority[priority] == taskId)
+        {
+            if (gTasks[taskId].prev != HEAD_SENTINEL && gTasks[gTasks[taskId].prev].priority == priority)
+                sLastTaskIdByPriority[priority] = gTasks[taskId].prev;
+            else
+                sUsedPriorityBits[priority / 32] &= ~(1u << (priority % 32));
+        }
+        sActiveTaskBits[taskId / 32] &= ~(1u << (taskId % 32));
+        sTaskCount--;
+
         if (gTasks[taskId].prev == HEAD_SENTINEL)
         {
+            sFirstTaskId = gTasks[taskId].next;
             if (gTasks[taskId].next != TAIL_SENTINEL)
                 gTasks[gTasks[taskId].next].prev = HEAD_SENTINEL;
         }
@@ -109,27 +189,33 @@ void DestroyTask(u8 taskId)
 
 void RunTasks(void)
 {
-    u8 taskId = FindFirstActiveTask();
+    u8 taskId;
 
-    if (taskId != NUM_TASKS)
+    if (sTaskCount != 0)
     {
+        taskId = sFirstTaskId;
         do
         {
-            gTasks[taskId].func(taskId);
+            if (sTaskFramesUntilRun[taskId] != 0)
+            {
+                sTaskFramesUntilRun[taskId]--;
+            }
+            else
+            {
+                sTaskFramesUntilRun[taskId] = sTaskFrameSkips[taskId];
+                PROFILE_CALL(PROFILE_TASK, gTasks[taskId].func, gTasks[taskId].func(taskId));
+            }
             taskId = gTasks[taskId].next;
         } while (taskId != TAIL_SENTINEL);
     }
 }
 
-static u8 FindFirstActiveTask(void)
+// Throttles a task so that after it runs, it sits out the next frameSkip frames.
+// Tasks that only need to poll for something can use this to stay out of the way.
+void SetTaskFrameSkip(u8 taskId, u8 frameSkip)
 {
-    u8 taskId;
-
-    for (taskId = 0; taskId < NUM_TASKS; taskId++)
-        if (gTasks[taskId].isActive == TRUE && gTasks[taskId].prev == HEAD_SENTINEL)
-            break;
-
-    return taskId;
+    sTaskFrameSkips[taskId] = frameSkip;
+    sTaskFramesUntilRun[taskId] = 0;
 }
 
 void TaskDummy(u8 taskId)
@@ -176,14 +262,7 @@ u8 FindTaskIdByFunc(TaskFunc func)
 
 u8 GetTaskCount(void)
 {
-    u8 i;
-    u8 count = 0;
-
-    for (i = 0; i < NUM_TASKS; i++)
-        if (gTasks[i].isActive == TRUE)
-            count++;
-
-    return count;
+    return sTaskCount;
 }
 
 void SetWordTaskArg(u8 taskId, u8 dataElem, u32 value)
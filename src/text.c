@@ -29,15 +29,22 @@ static void DecompressGlyph_Short(u16, bool32);
 static void DecompressGlyph_Narrow(u16, bool32);
 static void DecompressGlyph_SmallNarrow(u16, bool32);
 static void DecompressGlyph_Bold(u16);
-static u32 GetGlyphWidth_Small(u16, bool32);
-static u32 GetGlyphWidth_Normal(u16, bool32);
-static u32 GetGlyphWidth_Short(u16, bool32);
-static u32 GetGlyphWidth_Narrow(u16, bool32);
-static u32 GetGlyphWidth_SmallNarrow(u16, bool32);
 
 static EWRAM_DATA struct TextPrinter sTempTextPrinter = {0};
 static EWRAM_DATA struct TextPrinter sTextPrinters[WINDOWS_MAX] = {0};
 
+#define STRING_WIDTH_CACHE_SIZE 32
+
+struct StringWidth
+{
+    const u8 *str;
+    u8 fontId;
+    s16 letterSpacing;
+    s32 width;
+};
+
+static EWRAM_DATA struct StringWidth sStringWidthCache[STRING_WIDTH_CACHE_SIZE] = {0};
+
 static u16 sFontHalfRowLookupTable[0x51];
 static u16 sLastTextBgColor;
 static u16 sLastTextFgColor;
@@ -79,17 +86,19 @@ static const u8 sWindowVerticalScrollSpeeds[] = {
     [OPTIONS_TEXT_SPEED_FAST] = 4,
 };
 
-static const struct GlyphWidthFunc sGlyphWidthFuncs[] =
+// Glyph widths for GetStringWidth. Glyph sets without a table have the same
+// width for every glyph. Fonts not listed here can't be measured.
+static const struct GlyphWidths sGlyphWidths[] =
 {
-    { FONT_SMALL,        GetGlyphWidth_Small },
-    { FONT_NORMAL,       GetGlyphWidth_Normal },
-    { FONT_SHORT,        GetGlyphWidth_Short },
-    { FONT_SHORT_COPY_1, GetGlyphWidth_Short },
-    { FONT_SHORT_COPY_2, GetGlyphWidth_Short },
-    { FONT_SHORT_COPY_3, GetGlyphWidth_Short },
-    { FONT_BRAILLE,      GetGlyphWidth_Braille },
-    { FONT_NARROW,       GetGlyphWidth_Narrow },
-    { FONT_SMALL_NARROW, GetGlyphWidth_SmallNarrow }
+    [FONT_SMALL]        = { .latinWidths = gFontSmallLatinGlyphWidths,      .japaneseWidth = 8 },
+    [FONT_NORMAL]       = { .latinWidths = gFontNormalLatinGlyphWidths,     .japaneseWidth = 8 },
+    [FONT_SHORT]        = { .latinWidths = gFontShortLatinGlyphWidths,      .japaneseWidths = gFontShortJapaneseGlyphWidths },
+    [FONT_SHORT_COPY_1] = { .latinWidths = gFontShortLatinGlyphWidths,      .japaneseWidths = gFontShortJapaneseGlyphWidths },
+    [FONT_SHORT_COPY_2] = { .latinWidths = gFontShortLatinGlyphWidths,      .japaneseWidths = gFontShortJapaneseGlyphWidths },
+    [FONT_SHORT_COPY_3] = { .latinWidths = gFontShortLatinGlyphWidths,      .japaneseWidths = gFontShortJapaneseGlyphWidths },
+    [FONT_BRAILLE]      = { .latinWidth = 16,                               .japaneseWidth = 16 },
+    [FONT_NARROW]       = { .latinWidths = gFontNarrowLatinGlyphWidths,     .japaneseWidth = 8 },
+    [FONT_SMALL_NARROW] = { .latinWidths = gFontSmallNarrowLatinGlyphWidths, .japaneseWidth = 8 },
 };
 
 struct
@@ -569,27 +578,105 @@ static u8 UNUSED GetLastTextColor(u8 colorType)
     }
 }
 
-inline static void GLYPH_COPY(u8 *windowTiles, u32 widthOffset, u32 j, u32 i, u32 *glyphPixels, s32 width, s32 height)
+// Recently drawn glyphs are kept decompressed, since most text is made of the
+// same few letters. Entries are keyed by glyph and font, and also by the text
+// colors, which are baked into the decompressed pixels. The key of an unused
+// entry is 0, which never matches since GLYPH_CACHE_KEY always sets bit 25.
+#define GLYPH_CACHE_SIZE 16
+
+#define GLYPH_CACHE_KEY(fontId, glyphId, isJapanese) ((1 << 25) | ((isJapanese == TRUE) << 24) | ((fontId) << 16) | (glyphId))
+#define GLYPH_CACHE_COLORS() ((sLastTextShadowColor << 8) | (sLastTextBgColor << 4) | sLastTextFgColor)
+
+struct CachedGlyph
 {
-    u32 xAdd, yAdd, pixelData, bits, toOrr, dummyX;
-    u8 *dst;
+    u32 key;
+    u16 colors;
+    u32 lastUsed;
+    struct TextGlyph glyph;
+};
 
-    xAdd = j + width;
-    yAdd = i + height;
-    dummyX = j;
-    for (; i < yAdd; i++)
+static EWRAM_DATA struct CachedGlyph sGlyphCache[GLYPH_CACHE_SIZE] = {0};
+static EWRAM_DATA u32 sGlyphCacheClock = 0;
+
+static void DecompressGlyph(u8 fontId, u16 glyphId, bool32 isJapanese)
+{
+    struct CachedGlyph *entry;
+    struct CachedGlyph *oldest = &sGlyphCache[0];
+    u32 key = GLYPH_CACHE_KEY(fontId, glyphId, isJapanese);
+    u16 colors = GLYPH_CACHE_COLORS();
+    u32 i;
+
+    sGlyphCacheClock++;
+    for (i = 0; i < GLYPH_CACHE_SIZE; i++)
     {
-        pixelData = *glyphPixels++;
-        for (j = dummyX; j < xAdd; j++)
+        entry = &sGlyphCache[i];
+        if (entry->key == key && entry->colors == colors)
         {
-            if ((toOrr = pixelData & 0xF))
-            {
-                dst = windowTiles + ((j / 8) * 32) + ((j % 8) / 2) + ((i / 8) * widthOffset) + ((i % 8) * 4);
-                bits = ((j & 1) * 4);
-                *dst = (toOrr << bits) | (*dst & (0xF0 >> bits));
-            }
-            pixelData >>= 4;
+            entry->lastUsed = sGlyphCacheClock;
+            gCurGlyph = entry->glyph;
+            return;
         }
+        if (entry->lastUsed < oldest->lastUsed)
+            oldest = entry;
+    }
+
+    switch (fontId)
+    {
+    case FONT_SMALL:
+        DecompressGlyph_Small(glyphId, isJapanese);
+        break;
+    case FONT_NORMAL:
+        DecompressGlyph_Normal(glyphId, isJapanese);
+        break;
+    case FONT_SHORT:
+    case FONT_SHORT_COPY_1:
+    case FONT_SHORT_COPY_2:
+    case FONT_SHORT_COPY_3:
+        DecompressGlyph_Short(glyphId, isJapanese);
+        break;
+    case FONT_NARROW:
+        DecompressGlyph_Narrow(glyphId, isJapanese);
+        break;
+    case FONT_SMALL_NARROW:
+        DecompressGlyph_SmallNarrow(glyphId, isJapanese);
+        break;
+    default:
+        // Braille is drawn by its own font function
+        return;
+    }
+
+    oldest->key = key;
+    oldest->colors = colors;
+    oldest->lastUsed = sGlyphCacheClock;
+    oldest->glyph = gCurGlyph;
+}
+
+// Each row of a 4bpp tile is one word, so a glyph row lands in at most two
+// words of the window and is drawn with a shift and a mask. Pixels of color 0
+// are transparent.
+static inline void CopyGlyphTileToWindow(u8 *windowTiles, u32 widthOffset, u32 x, u32 y, const u32 *glyphPixels, s32 width, s32 height)
+{
+    u32 *dst;
+    u32 pixels, opaque, widthMask;
+    u32 shift = (x % 8) * 4;
+
+    if (width <= 0)
+        return;
+
+    widthMask = width >= 8 ? 0xFFFFFFFF : (1 << (width * 4)) - 1;
+    windowTiles += (x / 8) * 32;
+    for (; height > 0; height--, y++)
+    {
+        pixels = *glyphPixels++ & widthMask;
+        opaque = pixels | (pixels >> 1) | (pixels >> 2) | (pixels >> 3);
+        opaque = (opaque & 0x11111111) * 0xF;
+
+        dst = (u32 *)(windowTiles + ((y / 8) * widthOffset) + ((y % 8) * 4));
+        dst[0] = (dst[0] & ~(opaque << shift)) | (pixels << shift);
+
+        // The part that spills into the next tile
+        if (shift != 0 && (opaque >> (32 - shift)) != 0)
+            dst[8] = (dst[8] & ~(opaque >> (32 - shift))) | (pixels >> (32 - shift));
     }
 }
 
@@ -621,27 +708,27 @@ void CopyGlyphToWindow(struct TextPrinter *textPrinter)
     {
         if (glyphHeight < 9)
         {
-            GLYPH_COPY(windowTiles, widthOffset, currX, currY, glyphPixels, glyphWidth, glyphHeight);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX, currY, glyphPixels, glyphWidth, glyphHeight);
         }
         else
         {
-            GLYPH_COPY(windowTiles, widthOffset, currX, currY, glyphPixels, glyphWidth, 8);
-            GLYPH_COPY(windowTiles, widthOffset, currX, currY + 8, glyphPixels + 16, glyphWidth, glyphHeight - 8);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX, currY, glyphPixels, glyphWidth, 8);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX, currY + 8, glyphPixels + 16, glyphWidth, glyphHeight - 8);
         }
     }
     else
     {
         if (glyphHeight < 9)
         {
-            GLYPH_COPY(windowTiles, widthOffset, currX, currY, glyphPixels, 8, glyphHeight);
-            GLYPH_COPY(windowTiles, widthOffset, currX + 8, currY, glyphPixels + 8, glyphWidth - 8, glyphHeight);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX, currY, glyphPixels, 8, glyphHeight);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX + 8, currY, glyphPixels + 8, glyphWidth - 8, glyphHeight);
         }
         else
         {
-            GLYPH_COPY(windowTiles, widthOffset, currX, currY, glyphPixels, 8, 8);
-            GLYPH_COPY(windowTiles, widthOffset, currX + 8, currY, glyphPixels + 8, glyphWidth - 8, 8);
-            GLYPH_COPY(windowTiles, widthOffset, currX, currY + 8, glyphPixels + 16, 8, glyphHeight - 8);
-            GLYPH_COPY(windowTiles, widthOffset, currX + 8, currY + 8, glyphPixels + 24, glyphWidth - 8, glyphHeight - 8);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX, currY, glyphPixels, 8, 8);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX + 8, currY, glyphPixels + 8, glyphWidth - 8, 8);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX, currY + 8, glyphPixels + 16, 8, glyphHeight - 8);
+            CopyGlyphTileToWindow(windowTiles, widthOffset, currX + 8, currY + 8, glyphPixels + 24, glyphWidth - 8, glyphHeight - 8);
         }
     }
 }
@@ -1120,30 +1207,7 @@ static u16 RenderText(struct TextPrinter *textPrinter)
             return RENDER_FINISH;
         }
 
-        switch (subStruct->fontId)
-        {
-        case FONT_SMALL:
-            DecompressGlyph_Small(currChar, textPrinter->japanese);
-            break;
-        case FONT_NORMAL:
-            DecompressGlyph_Normal(currChar, textPrinter->japanese);
-            break;
-        case FONT_SHORT:
-        case FONT_SHORT_COPY_1:
-        case FONT_SHORT_COPY_2:
-        case FONT_SHORT_COPY_3:
-            DecompressGlyph_Short(currChar, textPrinter->japanese);
-            break;
-        case FONT_NARROW:
-            DecompressGlyph_Narrow(currChar, textPrinter->japanese);
-            break;
-        case FONT_SMALL_NARROW:
-            DecompressGlyph_SmallNarrow(currChar, textPrinter->japanese);
-            break;
-        case FONT_BRAILLE:
-            break;
-        }
-
+        DecompressGlyph(subStruct->fontId, currChar, textPrinter->japanese);
         CopyGlyphToWindow(textPrinter);
 
         if (textPrinter->minLetterSpacing)
@@ -1312,24 +1376,35 @@ static u32 UNUSED GetStringWidthFixedWidthFont(const u8 *str, u8 fontId, u8 lett
     return (u8)(GetFontAttribute(fontId, FONTATTR_MAX_LETTER_WIDTH) + letterSpacing) * width;
 }
 
-static u32 (*GetFontWidthFunc(u8 fontId))(u16, bool32)
+static const struct GlyphWidths *GetFontGlyphWidths(u8 fontId)
 {
-    u32 i;
+    const struct GlyphWidths *widths;
 
-    for (i = 0; i < ARRAY_COUNT(sGlyphWidthFuncs); ++i)
-    {
-        if (fontId == sGlyphWidthFuncs[i].fontId)
-            return sGlyphWidthFuncs[i].func;
-    }
+    if (fontId >= ARRAY_COUNT(sGlyphWidths))
+        return NULL;
+
+    widths = &sGlyphWidths[fontId];
+    if (widths->latinWidths == NULL && widths->latinWidth == 0)
+        return NULL;
 
-    return NULL;
+    return widths;
 }
 
-s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
+static inline u32 GetGlyphWidth(const struct GlyphWidths *widths, u16 glyphId, bool32 isJapanese)
+{
+    if (isJapanese == TRUE)
+        return widths->japaneseWidths != NULL ? widths->japaneseWidths[glyphId] : widths->japaneseWidth;
+    else
+        return widths->latinWidths != NULL ? widths->latinWidths[glyphId] : widths->latinWidth;
+}
+
+// Measures a string. isConstant is set to FALSE if the string has placeholders,
+// since their text can change without the string changing.
+static s32 MeasureString(u8 fontId, const u8 *str, s16 letterSpacing, bool32 *isConstant)
 {
     bool8 isJapanese;
     int minGlyphWidth;
-    u32 (*func)(u16 fontId, bool32 isJapanese);
+    const struct GlyphWidths *widths;
     int localLetterSpacing;
     u32 lineWidth;
     const u8 *bufferPointer;
@@ -1339,8 +1414,9 @@ s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
     isJapanese = 0;
     minGlyphWidth = 0;
 
-    func = GetFontWidthFunc(fontId);
-    if (func == NULL)
+    *isConstant = TRUE;
+    widths = GetFontGlyphWidths(fontId);
+    if (widths == NULL)
         return 0;
 
     if (letterSpacing == -1)
@@ -1362,6 +1438,7 @@ s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
             lineWidth = 0;
             break;
         case PLACEHOLDER_BEGIN:
+            *isConstant = FALSE;
             switch (*++str)
             {
             case PLACEHOLDER_ID_STRING_VAR_1:
@@ -1377,11 +1454,12 @@ s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
                 return 0;
             }
         case CHAR_DYNAMIC:
+            *isConstant = FALSE;
             if (bufferPointer == NULL)
                 bufferPointer = DynamicPlaceholderTextUtil_GetPlaceholderPtr(*++str);
             while (*bufferPointer != EOS)
             {
-                glyphWidth = func(*bufferPointer++, isJapanese);
+                glyphWidth = GetGlyphWidth(widths, *bufferPointer++, isJapanese);
                 if (minGlyphWidth > 0)
                 {
                     if (glyphWidth < minGlyphWidth)
@@ -1416,8 +1494,8 @@ s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
                 ++str;
                 break;
             case EXT_CTRL_CODE_FONT:
-                func = GetFontWidthFunc(*++str);
-                if (func == NULL)
+                widths = GetFontGlyphWidths(*++str);
+                if (widths == NULL)
                     return 0;
                 if (letterSpacing == -1)
                     localLetterSpacing = GetFontAttribute(*str, FONTATTR_LETTER_SPACING);
@@ -1453,7 +1531,7 @@ s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
         case CHAR_KEYPAD_ICON:
         case CHAR_EXTRA_SYMBOL:
             if (*str == CHAR_EXTRA_SYMBOL)
-                glyphWidth = func(*++str | 0x100, isJapanese);
+                glyphWidth = GetGlyphWidth(widths, *++str | 0x100, isJapanese);
             else
                 glyphWidth = GetKeypadIconWidth(*++str);
 
@@ -1474,7 +1552,7 @@ s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
         case CHAR_PROMPT_CLEAR:
             break;
         default:
-            glyphWidth = func(*str, isJapanese);
+            glyphWidth = GetGlyphWidth(widths, *str, isJapanese);
             if (minGlyphWidth > 0)
             {
                 if (glyphWidth < minGlyphWidth)
@@ -1497,6 +1575,33 @@ s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
     return width;
 }
 
+// Menus measure the same strings on every redraw to align them, so the widths
+// of strings in ROM are remembered. Strings in RAM can change, so they are
+// measured every time.
+s32 GetStringWidth(u8 fontId, const u8 *str, s16 letterSpacing)
+{
+    struct StringWidth *cached;
+    bool32 isConstant;
+    s32 width;
+
+    if ((u32)str < ROM_START || (u32)str >= ROM_END)
+        return MeasureString(fontId, str, letterSpacing, &isConstant);
+
+    cached = &sStringWidthCache[(u32)str % STRING_WIDTH_CACHE_SIZE];
+    if (cached->str == str && cached->fontId == fontId && cached->letterSpacing == letterSpacing)
+        return cached->width;
+
+    width = MeasureString(fontId, str, letterSpacing, &isConstant);
+    if (isConstant)
+    {
+        cached->str = str;
+        cached->fontId = fontId;
+        cached->letterSpacing = letterSpacing;
+        cached->width = width;
+    }
+    return width;
+}
+
 u8 RenderTextHandleBold(u8 *pixels, u8 fontId, u8 *str)
 {
     u8 shadowColor;
@@ -1714,14 +1819,6 @@ static void DecompressGlyph_Small(u16 glyphId, bool32 isJapanese)
     }
 }
 
-static u32 GetGlyphWidth_Small(u16 glyphId, bool32 isJapanese)
-{
-    if (isJapanese == TRUE)
-        return 8;
-    else
-        return gFontSmallLatinGlyphWidths[glyphId];
-}
-
 static void DecompressGlyph_Narrow(u16 glyphId, bool32 isJapanese)
 {
     const u16 *glyphs;
@@ -1756,14 +1853,6 @@ static void DecompressGlyph_Narrow(u16 glyphId, bool32 isJapanese)
     }
 }
 
-static u32 GetGlyphWidth_Narrow(u16 glyphId, bool32 isJapanese)
-{
-    if (isJapanese == TRUE)
-        return 8;
-    else
-        return gFontNarrowLatinGlyphWidths[glyphId];
-}
-
 static void DecompressGlyph_SmallNarrow(u16 glyphId, bool32 isJapanese)
 {
     const u16 *glyphs;
@@ -1798,14 +1887,6 @@ static void DecompressGlyph_SmallNarrow(u16 glyphId, bool32 isJapanese)
     }
 }
 
-static u32 GetGlyphWidth_SmallNarrow(u16 glyphId, bool32 isJapanese)
-{
-    if (isJapanese == TRUE)
-        return 8;
-    else
-        return gFontSmallNarrowLatinGlyphWidths[glyphId];
-}
-
 static void DecompressGlyph_Short(u16 glyphId, bool32 isJapanese)
 {
     const u16 *glyphs;
@@ -1842,14 +1923,6 @@ static void DecompressGlyph_Short(u16 glyphId, bool32 isJapanese)
     }
 }
 
-static u32 GetGlyphWidth_Short(u16 glyphId, bool32 isJapanese)
-{
-    if (isJapanese == TRUE)
-        return gFontShortJapaneseGlyphWidths[glyphId];
-    else
-        return gFontShortLatinGlyphWidths[glyphId];
-}
-
 static void DecompressGlyph_Normal(u16 glyphId, bool32 isJapanese)
 {
     const u16 *glyphs;
@@ -1884,14 +1957,6 @@ static void DecompressGlyph_Normal(u16 glyphId, bool32 isJapanese)
     }
 }
 
-static u32 GetGlyphWidth_Normal(u16 glyphId, bool32 isJapanese)
-{
-    if (isJapanese == TRUE)
-        return 8;
-    else
-        return gFontNormalLatinGlyphWidths[glyphId];
-}
-
 static void DecompressGlyph_Bold(u16 glyphId)
 {
     const u16 *glyphs;
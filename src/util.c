@@ -276,4 +276,5 @@ void BlendPalette(u16 palOffset, u16 numEntries, u8 coeff, u16 blendColor)
                                       g + (((data2->g - g) * coeff) >> 4),
                                       b + (((data2->b - b) * coeff) >> 4));
     }
+    MarkPlttBufferDirty(palOffset, PLTT_SIZEOF(numEntries));
 }
@@ -76,6 +76,7 @@ bool16 InitWindows(const struct WindowTemplate *templates)
 
                 gWindowBgTilemapBuffers[bgLayer] = allocatedTilemapBuffer;
                 SetBgTilemapBuffer(bgLayer, allocatedTilemapBuffer);
+                SetBgTilemapBufferFullUploads(bgLayer, FALSE);
             }
         }
 
@@ -151,6 +152,7 @@ u16 AddWindow(const struct WindowTemplate *template)
 
             gWindowBgTilemapBuffers[bgLayer] = allocatedTilemapBuffer;
             SetBgTilemapBuffer(bgLayer, allocatedTilemapBuffer);
+            SetBgTilemapBufferFullUploads(bgLayer, FALSE);
         }
     }
 
@@ -624,6 +626,7 @@ u16 AddWindow8Bit(const struct WindowTemplate *template)
                 memAddress[i] = 0;
             gWindowBgTilemapBuffers[bgLayer] = memAddress;
             SetBgTilemapBuffer(bgLayer, memAddress);
+            SetBgTilemapBufferFullUploads(bgLayer, FALSE);
         }
     }
     memAddress = Alloc((u16)(64 * (template->width * template->height)));
@@ -0,0 +1,391 @@
+// frameprof: prints a report of the frame profiler's ring buffer.
+//
+// Build the ROM with `make PROFILE=1`, play until the slowdown happens, dump
+// EWRAM from the emulator and run:
+//
+//   frameprof pokeemerald_modern.sym ewram.bin
+//
+// The dump is assumed to start at 0x02000000 (-b changes that). -f writes the
+// recorded call stacks in the "folded" format read by flamegraph.pl.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define FATAL_ERROR(format, ...)                 \
+do                                               \
+{                                                \
+    std::fprintf(stderr, format, ##__VA_ARGS__); \
+    std::exit(1);                                \
+} while (0)
+
+// Keep in sync with include/frame_profiler.h.
+static const uint32_t kProfilerMagic = 0x464F5250;
+static const char *const kProfilerSymbol = "gFrameProfiler";
+static const size_t kHeaderSize = 16;
+static const size_t kEntrySize = 8;
+
+enum ProfileKind
+{
+    PROFILE_FRAME,
+    PROFILE_CALLBACK1,
+    PROFILE_CALLBACK2,
+    PROFILE_TASK,
+    PROFILE_SPRITE_CALLBACK,
+    NUM_PROFILE_KINDS
+};
+
+static const char *const kKindNames[NUM_PROFILE_KINDS] = {"frame", "callback1", "callback2", "task", "sprite"};
+
+// 228 lines of 1232 cycles.
+static const uint32_t kFrameCycles = 280896;
+
+static const char *const USAGE = "Usage: frameprof [-b DUMP_BASE_ADDRESS] [-n TOP_COUNT] [-f FOLDED_OUTPUT] SYM_FILE DUMP_FILE\n";
+
+struct Symbol
+{
+    uint32_t address;
+    uint32_t size;
+    std::string name;
+};
+
+struct CallNode
+{
+    uint32_t func;
+    uint32_t cycles;
+    int depth;
+    int kind;
+    std::vector<std::unique_ptr<CallNode>> children;
+
+    uint32_t SelfCycles() const
+    {
+        uint64_t childCycles = 0;
+        for (const auto& child : children)
+            childCycles += child->cycles;
+        return childCycles >= cycles ? 0 : cycles - (uint32_t)childCycles;
+    }
+};
+
+struct FunctionStats
+{
+    int kind;
+    uint32_t calls = 0;
+    uint64_t totalCycles = 0;
+    uint64_t selfCycles = 0;
+    uint32_t maxCycles = 0;
+};
+
+class SymbolTable
+{
+public:
+    explicit SymbolTable(const std::string& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+            FATAL_ERROR("Couldn't open symbol file \"%s\".\n", path.c_str());
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream fields(line);
+            std::string address, type, size, name;
+            if (!(fields >> address >> type >> size >> name))
+                continue;
+
+            Symbol symbol{(uint32_t)std::strtoul(address.c_str(), nullptr, 16), (uint32_t)std::strtoul(size.c_str(), nullptr, 16), name};
+            m_byName[name] = symbol.address;
+            if (symbol.address >= 0x08000000 && symbol.address < 0x0A000000)
+                m_code.push_back(symbol);
+        }
+
+        std::sort(m_code.begin(), m_code.end(), [](const Symbol& a, const Symbol& b) { return a.address < b.address; });
+    }
+
+    bool Find(const std::string& name, uint32_t& address) const
+    {
+        auto it = m_byName.find(name);
+        if (it == m_byName.end())
+            return false;
+        address = it->second;
+        return true;
+    }
+
+    // Function pointers have the Thumb bit set, which the symbol file may not.
+    std::string NameOf(uint32_t address) const
+    {
+        uint32_t target = address & ~1;
+        auto it = std::upper_bound(m_code.begin(), m_code.end(), target, [](uint32_t value, const Symbol& symbol) { return value < (symbol.address & ~1); });
+        char buffer[32];
+
+        if (it != m_code.begin())
+        {
+            const Symbol& symbol = *(it - 1);
+            uint32_t offset = target - (symbol.address & ~1);
+            if (offset == 0)
+                return symbol.name;
+            if (offset < symbol.size)
+            {
+                std::snprintf(buffer, sizeof(buffer), "+0x%X", offset);
+                return symbol.name + buffer;
+            }
+        }
+
+        std::snprintf(buffer, sizeof(buffer), "0x%08X", address);
+        return buffer;
+    }
+
+private:
+    std::map<std::string, uint32_t> m_byName;
+    std::vector<Symbol> m_code;
+};
+
+static uint32_t ReadU32(const std::vector<uint8_t>& data, size_t offset)
+{
+    return data[offset] | (data[offset + 1] << 8) | (data[offset + 2] << 16) | ((uint32_t)data[offset + 3] << 24);
+}
+
+static uint16_t ReadU16(const std::vector<uint8_t>& data, size_t offset)
+{
+    return data[offset] | (data[offset + 1] << 8);
+}
+
+static std::vector<uint8_t> ReadWholeFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        FATAL_ERROR("Couldn't open dump file \"%s\".\n", path.c_str());
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Entries are written when calls return, so every call follows its children.
+// Rebuild the call trees by letting each entry adopt the deeper entries that
+// are still waiting for a parent.
+static std::vector<std::unique_ptr<CallNode>> BuildFrames(const std::vector<uint8_t>& dump, size_t profilerOffset)
+{
+    uint16_t numEntries = ReadU16(dump, profilerOffset + 4);
+    uint16_t head = ReadU16(dump, profilerOffset + 6);
+    uint32_t totalEntries = ReadU32(dump, profilerOffset + 8);
+    bool wrapped = totalEntries > numEntries;
+    uint32_t count = wrapped ? numEntries : totalEntries;
+    uint32_t first = wrapped ? head : 0;
+    bool skipPartialFrame = wrapped;
+
+    if (profilerOffset + kHeaderSize + numEntries * kEntrySize > dump.size())
+        FATAL_ERROR("The dump ends inside the profiler's ring buffer.\n");
+
+    std::vector<std::unique_ptr<CallNode>> frames;
+    std::vector<std::unique_ptr<CallNode>> pending;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        size_t offset = profilerOffset + kHeaderSize + ((first + i) % numEntries) * kEntrySize;
+        uint32_t packed = ReadU32(dump, offset + 4);
+        std::unique_ptr<CallNode> node(new CallNode);
+
+        node->func = ReadU32(dump, offset);
+        node->cycles = packed & 0xFFFFFF;
+        node->depth = (packed >> 24) & 0xF;
+        node->kind = (packed >> 28) & 0xF;
+        if (node->kind >= NUM_PROFILE_KINDS)
+            FATAL_ERROR("Entry %u has unknown kind %d. Is the dump base address right?\n", i, node->kind);
+
+        auto firstChild = pending.end();
+        while (firstChild != pending.begin() && (*(firstChild - 1))->depth > node->depth)
+            --firstChild;
+        std::move(firstChild, pending.end(), std::back_inserter(node->children));
+        pending.erase(firstChild, pending.end());
+
+        if (node->kind != PROFILE_FRAME)
+        {
+            pending.push_back(std::move(node));
+            continue;
+        }
+
+        // When the ring buffer has wrapped, the oldest frame lost its first calls.
+        if (!skipPartialFrame)
+            frames.push_back(std::move(node));
+        skipPartialFrame = false;
+        pending.clear();
+    }
+
+    return frames;
+}
+
+static std::string NodeName(const CallNode& node, const SymbolTable& symbols)
+{
+    if (node.kind == PROFILE_FRAME)
+        return "frame";
+    return symbols.NameOf(node.func);
+}
+
+static void CollectStats(const CallNode& node, const SymbolTable& symbols, std::map<std::string, FunctionStats>& stats)
+{
+    for (const auto& child : node.children)
+    {
+        FunctionStats& entry = stats[symbols.NameOf(child->func)];
+        entry.kind = child->kind;
+        entry.calls++;
+        entry.totalCycles += child->cycles;
+        entry.selfCycles += child->SelfCycles();
+        entry.maxCycles = std::max(entry.maxCycles, child->cycles);
+        CollectStats(*child, symbols, stats);
+    }
+}
+
+static void CollectFolded(const CallNode& node, const std::string& stack, const SymbolTable& symbols, std::map<std::string, uint64_t>& folded)
+{
+    std::string path = stack.empty() ? NodeName(node, symbols) : stack + ";" + NodeName(node, symbols);
+
+    folded[path] += node.SelfCycles();
+    for (const auto& child : node.children)
+        CollectFolded(*child, path, symbols, folded);
+}
+
+// Prints a call tree with a bar scaled to the frame budget, so the calls that
+// push a frame over budget stand out.
+static void PrintTree(const CallNode& node, const SymbolTable& symbols, int indent)
+{
+    const int barWidth = 40;
+    int barLength = (int)std::min<uint64_t>((uint64_t)node.cycles * barWidth / kFrameCycles, barWidth);
+
+    std::printf("  %8u %5.1f%% %-*s|%-*s| %s\n",
+                node.cycles,
+                100.0 * node.cycles / kFrameCycles,
+                indent * 2, "",
+                barWidth, std::string(barLength, '#').c_str(),
+                NodeName(node, symbols).c_str());
+    for (const auto& child : node.children)
+        PrintTree(*child, symbols, indent + 1);
+}
+
+static void PrintReport(const std::vector<std::unique_ptr<CallNode>>& frames, const SymbolTable& symbols, int topCount)
+{
+    uint64_t totalCycles = 0;
+    int overBudget = 0;
+
+    for (const auto& frame : frames)
+    {
+        totalCycles += frame->cycles;
+        if (frame->cycles > kFrameCycles)
+            overBudget++;
+    }
+
+    std::printf("%zu frames (%u to %u), %d over the budget of %u cycles\n",
+                frames.size(), frames.front()->func, frames.back()->func, overBudget, kFrameCycles);
+    std::printf("Average frame: %llu cycles (%.1f%% of budget)\n\n",
+                (unsigned long long)(totalCycles / frames.size()), 100.0 * totalCycles / frames.size() / kFrameCycles);
+
+    std::map<std::string, FunctionStats> stats;
+    for (const auto& frame : frames)
+        CollectStats(*frame, symbols, stats);
+
+    std::vector<std::pair<std::string, FunctionStats>> sorted(stats.begin(), stats.end());
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, FunctionStats>& a, const std::pair<std::string, FunctionStats>& b) {
+        return a.second.selfCycles > b.second.selfCycles;
+    });
+
+    std::printf("Functions by self cycles per frame:\n");
+    std::printf("  %-9s %7s %10s %10s %10s  %s\n", "kind", "calls", "self/frame", "total/call", "max", "function");
+    for (int i = 0; i < (int)sorted.size() && i < topCount; i++)
+    {
+        const FunctionStats& entry = sorted[i].second;
+        std::printf("  %-9s %7u %10llu %10llu %10u  %s\n",
+                    kKindNames[entry.kind],
+                    entry.calls,
+                    (unsigned long long)(entry.selfCycles / frames.size()),
+                    (unsigned long long)(entry.totalCycles / entry.calls),
+                    entry.maxCycles,
+                    sorted[i].first.c_str());
+    }
+
+    std::vector<const CallNode *> slowest;
+    for (const auto& frame : frames)
+        slowest.push_back(frame.get());
+    std::sort(slowest.begin(), slowest.end(), [](const CallNode *a, const CallNode *b) { return a->cycles > b->cycles; });
+
+    for (int i = 0; i < (int)slowest.size() && i < 3; i++)
+    {
+        std::printf("\nFrame %u:\n", slowest[i]->func);
+        PrintTree(*slowest[i], symbols, 0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t dumpBase = 0x02000000;
+    int topCount = 20;
+    std::string foldedPath;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg(argv[i]);
+
+        if (arg == "-b" || arg == "-n" || arg == "-f")
+        {
+            if (i + 1 >= argc)
+                FATAL_ERROR(USAGE);
+            std::string value(argv[++i]);
+            if (arg == "-b")
+                dumpBase = std::strtoul(value.c_str(), nullptr, 0);
+            else if (arg == "-n")
+                topCount = std::atoi(value.c_str());
+            else
+                foldedPath = value;
+        }
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            paths.push_back(arg);
+        }
+        else
+        {
+            FATAL_ERROR(USAGE);
+        }
+    }
+
+    if (paths.size() != 2)
+        FATAL_ERROR(USAGE);
+
+    SymbolTable symbols(paths[0]);
+    std::vector<uint8_t> dump = ReadWholeFile(paths[1]);
+    uint32_t profilerAddress;
+
+    if (!symbols.Find(kProfilerSymbol, profilerAddress))
+        FATAL_ERROR("%s isn't in the symbol file. Was the ROM built with PROFILE=1?\n", kProfilerSymbol);
+    if (profilerAddress < dumpBase || profilerAddress - dumpBase + kHeaderSize > dump.size())
+        FATAL_ERROR("%s (0x%08X) isn't inside the dump.\n", kProfilerSymbol, profilerAddress);
+
+    size_t profilerOffset = profilerAddress - dumpBase;
+    if (ReadU32(dump, profilerOffset) != kProfilerMagic)
+        FATAL_ERROR("No profiler data at 0x%08X. Was the dump taken from the same build as the symbol file?\n", profilerAddress);
+
+    std::vector<std::unique_ptr<CallNode>> frames = BuildFrames(dump, profilerOffset);
+    if (frames.empty())
+        FATAL_ERROR("No complete frames were recorded.\n");
+
+    PrintReport(frames, symbols, topCount);
+
+    if (!foldedPath.empty())
+    {
+        std::map<std::string, uint64_t> folded;
+        for (const auto& frame : frames)
+            CollectFolded(*frame, "", symbols, folded);
+
+        std::FILE *fp = std::fopen(foldedPath.c_str(), "w");
+        if (fp == nullptr)
+            FATAL_ERROR("Couldn't write \"%s\".\n", foldedPath.c_str());
+        for (const auto& stack : folded)
+            std::fprintf(fp, "%s %llu\n", stack.first.c_str(), (unsigned long long)stack.second);
+        std::fclose(fp);
+    }
+
+    return 0;
+}
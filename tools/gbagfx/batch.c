@@ -0,0 +1,233 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "global.h"
+#include "util.h"
+#include "batch.h"
+
+// The manifest has one conversion per line, written as it would be passed on
+// the command line: "INPUT_PATH OUTPUT_PATH [options...]". Blank lines and
+// lines starting with '#' are ignored. A conversion whose input is the output
+// of an earlier line waits for that line to finish, so chains such as
+// png -> 4bpp -> 4bpp.lz can be listed in order.
+
+struct BatchJob
+{
+    int argc;
+    char **argv;
+    int dependency; // index of the job that produces this job's input, or -1
+    bool done;
+};
+
+struct BatchState
+{
+    struct BatchJob *jobs;
+    int numJobs;
+    int nextJob;
+    BatchConvertFunc convert;
+    pthread_mutex_t mutex;
+    pthread_cond_t jobDone;
+};
+
+struct OutputIndex
+{
+    char *path;
+    int job;
+};
+
+static int CompareOutputIndices(const void *a, const void *b)
+{
+    return strcmp(((const struct OutputIndex *)a)->path, ((const struct OutputIndex *)b)->path);
+}
+
+static int ParseManifest(char *manifest, int manifestSize, struct BatchJob **jobsOut)
+{
+    int maxJobs = 1;
+
+    for (int i = 0; i < manifestSize; i++)
+        if (manifest[i] == '\n')
+            maxJobs++;
+
+    struct BatchJob *jobs = malloc(maxJobs * sizeof(struct BatchJob));
+
+    if (jobs == NULL)
+        FATAL_ERROR("Failed to allocate batch jobs.\n");
+
+    int numJobs = 0;
+    char *line = manifest;
+    char *manifestEnd = manifest + manifestSize;
+
+    while (line < manifestEnd)
+    {
+        char *lineEnd = memchr(line, '\n', manifestEnd - line);
+
+        if (lineEnd == NULL)
+            lineEnd = manifestEnd;
+
+        *lineEnd = 0;
+
+        // Tokens are at most every other character, plus the program name and terminator.
+        int maxArgs = (lineEnd - line + 1) / 2 + 2;
+        char **argv = malloc(maxArgs * sizeof(char *));
+
+        if (argv == NULL)
+            FATAL_ERROR("Failed to allocate batch job arguments.\n");
+
+        int argc = 0;
+        argv[argc++] = "gbagfx";
+
+        for (char *token = strtok(line, " \t\r"); token != NULL; token = strtok(NULL, " \t\r"))
+        {
+            if (argc == 1 && token[0] == '#')
+                break;
+
+            argv[argc++] = token;
+        }
+
+        argv[argc] = NULL;
+
+        if (argc == 1)
+        {
+            free(argv);
+        }
+        else
+        {
+            if (argc < 3)
+                FATAL_ERROR("Batch manifest line \"%s\" has no output path.\n", argv[1]);
+
+            jobs[numJobs].argc = argc;
+            jobs[numJobs].argv = argv;
+            jobs[numJobs].dependency = -1;
+            jobs[numJobs].done = false;
+            numJobs++;
+        }
+
+        line = lineEnd + 1;
+    }
+
+    *jobsOut = jobs;
+    return numJobs;
+}
+
+static void ResolveDependencies(struct BatchJob *jobs, int numJobs)
+{
+    if (numJobs == 0)
+        return;
+
+    struct OutputIndex *outputs = malloc(numJobs * sizeof(struct OutputIndex));
+
+    if (outputs == NULL)
+        FATAL_ERROR("Failed to allocate batch output index.\n");
+
+    for (int i = 0; i < numJobs; i++)
+    {
+        outputs[i].path = jobs[i].argv[2];
+        outputs[i].job = i;
+    }
+
+    qsort(outputs, numJobs, sizeof(struct OutputIndex), CompareOutputIndices);
+
+    for (int i = 1; i < numJobs; i++)
+        if (strcmp(outputs[i - 1].path, outputs[i].path) == 0)
+            FATAL_ERROR("\"%s\" is the output of more than one batch manifest line.\n", outputs[i].path);
+
+    for (int i = 0; i < numJobs; i++)
+    {
+        struct OutputIndex key = { jobs[i].argv[1], 0 };
+        struct OutputIndex *producer = bsearch(&key, outputs, numJobs, sizeof(struct OutputIndex), CompareOutputIndices);
+
+        if (producer != NULL)
+        {
+            if (producer->job >= i)
+                FATAL_ERROR("\"%s\" is used by a batch manifest line before the line that produces it.\n", key.path);
+
+            jobs[i].dependency = producer->job;
+        }
+    }
+
+    free(outputs);
+}
+
+static void *BatchWorker(void *arg)
+{
+    struct BatchState *state = arg;
+
+    pthread_mutex_lock(&state->mutex);
+
+    while (state->nextJob < state->numJobs)
+    {
+        struct BatchJob *job = &state->jobs[state->nextJob++];
+
+        // Dependencies always come earlier in the manifest, so they have
+        // already been claimed by a worker and will eventually finish.
+        while (job->dependency >= 0 && !state->jobs[job->dependency].done)
+            pthread_cond_wait(&state->jobDone, &state->mutex);
+
+        pthread_mutex_unlock(&state->mutex);
+        state->convert(job->argc, job->argv);
+        pthread_mutex_lock(&state->mutex);
+
+        job->done = true;
+        pthread_cond_broadcast(&state->jobDone);
+    }
+
+    pthread_mutex_unlock(&state->mutex);
+
+    return NULL;
+}
+
+int GetDefaultBatchThreadCount(void)
+{
+    long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return numCpus > 0 ? (int)numCpus : 1;
+}
+
+void RunBatch(char *manifestPath, int numThreads, BatchConvertFunc convert)
+{
+    int manifestSize;
+    char *manifest = (char *)ReadWholeFileZeroPadded(manifestPath, &manifestSize, 1);
+
+    struct BatchState state;
+    state.numJobs = ParseManifest(manifest, manifestSize, &state.jobs);
+    state.nextJob = 0;
+    state.convert = convert;
+
+    ResolveDependencies(state.jobs, state.numJobs);
+
+    if (numThreads > state.numJobs)
+        numThreads = state.numJobs;
+
+    if (numThreads < 1)
+        numThreads = 1;
+
+    pthread_mutex_init(&state.mutex, NULL);
+    pthread_cond_init(&state.jobDone, NULL);
+
+    pthread_t *threads = malloc(numThreads * sizeof(pthread_t));
+
+    if (threads == NULL)
+        FATAL_ERROR("Failed to allocate batch threads.\n");
+
+    for (int i = 0; i < numThreads; i++)
+        if (pthread_create(&threads[i], NULL, BatchWorker, &state) != 0)
+            FATAL_ERROR("Failed to start batch thread.\n");
+
+    for (int i = 0; i < numThreads; i++)
+        pthread_join(threads[i], NULL);
+
+    pthread_cond_destroy(&state.jobDone);
+    pthread_mutex_destroy(&state.mutex);
+
+    for (int i = 0; i < state.numJobs; i++)
+        free(state.jobs[i].argv);
+
+    free(threads);
+    free(state.jobs);
+    free(manifest);
+}
@@ -0,0 +1,11 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// Runs a single conversion given gbagfx-style arguments: argv[1] is the input
+// path, argv[2] is the output path and any options follow.
+typedef void (*BatchConvertFunc)(int argc, char **argv);
+
+void RunBatch(char *manifestPath, int numThreads, BatchConvertFunc convert);
+int GetDefaultBatchThreadCount(void);
+
+#endif // BATCH_H
@@ -69,7 +69,160 @@ fail:
 	FATAL_ERROR("Fatal error while decompressing LZ file.\n");
 }
 
-unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize, const int minDistance)
+// The window size and longest block the GBA BIOS LZ77 format can encode.
+#define LZ_MAX_DISTANCE 0x1000
+#define LZ_MIN_BLOCK_SIZE 3
+#define LZ_MAX_BLOCK_SIZE 18
+
+#define LZ_HASH_BITS 15
+#define LZ_HASH_SIZE (1 << LZ_HASH_BITS)
+
+struct LZMatchFinder {
+	unsigned char *src;
+	int srcSize;
+	int minDistance;
+	int *head; // most recent position for each hash of three bytes
+	int *prev; // previous position with the same hash, for each position
+	int nextInsertPos;
+};
+
+static int GetBlockSize(struct LZMatchFinder *finder, int srcPos, int blockStart)
+{
+	int blockSize = 0;
+
+	while (blockSize < LZ_MAX_BLOCK_SIZE
+	    && srcPos + blockSize < finder->srcSize
+	    && finder->src[blockStart + blockSize] == finder->src[srcPos + blockSize])
+		blockSize++;
+
+	return blockSize;
+}
+
+// Tries every distance in the window, preferring the nearest of the longest blocks.
+static int FindBestBlockBruteForce(struct LZMatchFinder *finder, int srcPos, int *bestBlockDistance)
+{
+	int bestBlockSize = 0;
+	int blockDistance = finder->minDistance;
+
+	*bestBlockDistance = 0;
+
+	while (blockDistance <= srcPos && blockDistance <= LZ_MAX_DISTANCE) {
+		int blockSize = GetBlockSize(finder, srcPos, srcPos - blockDistance);
+
+		if (blockSize > bestBlockSize) {
+			*bestBlockDistance = blockDistance;
+			bestBlockSize = blockSize;
+
+			if (blockSize == LZ_MAX_BLOCK_SIZE)
+				break;
+		}
+
+		blockDistance++;
+	}
+
+	return bestBlockSize;
+}
+
+static unsigned int HashThreeBytes(unsigned char *p)
+{
+	unsigned int value = (p[0] << 16) | (p[1] << 8) | p[2];
+
+	return (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static void InsertHashPositions(struct LZMatchFinder *finder, int endPos)
+{
+	while (finder->nextInsertPos < endPos && finder->nextInsertPos + LZ_MIN_BLOCK_SIZE <= finder->srcSize) {
+		int pos = finder->nextInsertPos++;
+		unsigned int hash = HashThreeBytes(&finder->src[pos]);
+
+		finder->prev[pos] = finder->head[hash];
+		finder->head[hash] = pos;
+	}
+}
+
+// Only visits earlier positions whose first three bytes hash the same as srcPos.
+// Any block long enough to be encoded starts at one of these, and they are
+// visited nearest first, so the result matches FindBestBlockBruteForce.
+static int FindBestBlockHashChain(struct LZMatchFinder *finder, int srcPos, int *bestBlockDistance)
+{
+	int bestBlockSize = 0;
+
+	*bestBlockDistance = 0;
+
+	InsertHashPositions(finder, srcPos);
+
+	if (srcPos + LZ_MIN_BLOCK_SIZE > finder->srcSize)
+		return 0;
+
+	int blockStart = finder->head[HashThreeBytes(&finder->src[srcPos])];
+
+	while (blockStart >= 0) {
+		int blockDistance = srcPos - blockStart;
+
+		if (blockDistance > LZ_MAX_DISTANCE)
+			break;
+
+		if (blockDistance >= finder->minDistance) {
+			int blockSize = GetBlockSize(finder, srcPos, blockStart);
+
+			if (blockSize > bestBlockSize) {
+				*bestBlockDistance = blockDistance;
+				bestBlockSize = blockSize;
+
+				if (blockSize == LZ_MAX_BLOCK_SIZE)
+					break;
+			}
+		}
+
+		blockStart = finder->prev[blockStart];
+	}
+
+	return bestBlockSize;
+}
+
+// Each literal costs a flag bit and a byte; each block costs a flag bit and two bytes.
+#define LZ_LITERAL_COST 9
+#define LZ_BLOCK_COST 17
+
+// Chooses the block size at every position by a shortest-path search from the
+// end of the data, instead of greedily taking the longest block. A block of
+// any size between the minimum and the longest available one can be encoded
+// at the same distance, so only the longest block at each position is needed.
+static bool PlanOptimalParse(struct LZMatchFinder *finder, int *blockSizes, int *blockDistances)
+{
+	int srcSize = finder->srcSize;
+	int *costs = malloc((srcSize + 1) * sizeof(int));
+
+	if (costs == NULL)
+		return false;
+
+	for (int srcPos = 0; srcPos < srcSize; srcPos++)
+		blockSizes[srcPos] = FindBestBlockHashChain(finder, srcPos, &blockDistances[srcPos]);
+
+	costs[srcSize] = 0;
+
+	for (int srcPos = srcSize - 1; srcPos >= 0; srcPos--) {
+		int longestBlockSize = blockSizes[srcPos];
+
+		costs[srcPos] = LZ_LITERAL_COST + costs[srcPos + 1];
+		blockSizes[srcPos] = 0;
+
+		for (int blockSize = longestBlockSize; blockSize >= LZ_MIN_BLOCK_SIZE; blockSize--) {
+			int cost = LZ_BLOCK_COST + costs[srcPos + blockSize];
+
+			if (cost < costs[srcPos]) {
+				costs[srcPos] = cost;
+				blockSizes[srcPos] = blockSize;
+			}
+		}
+	}
+
+	free(costs);
+	return true;
+}
+
+unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize, const int minDistance, const bool fast, const bool optimal)
 {
 	if (srcSize <= 0)
 		goto fail;
@@ -84,6 +237,40 @@ unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize,
 	if (dest == NULL)
 		goto fail;
 
+	struct LZMatchFinder finder = {
+		.src = src,
+		.srcSize = srcSize,
+		.minDistance = minDistance,
+		.head = NULL,
+		.prev = NULL,
+		.nextInsertPos = 0,
+	};
+
+	int *plannedBlockSizes = NULL;
+	int *plannedBlockDistances = NULL;
+
+	if (fast || optimal) {
+		finder.head = malloc(LZ_HASH_SIZE * sizeof(int));
+		finder.prev = malloc(srcSize * sizeof(int));
+
+		if (finder.head == NULL || finder.prev == NULL)
+			goto fail;
+
+		for (int i = 0; i < LZ_HASH_SIZE; i++)
+			finder.head[i] = -1;
+	}
+
+	if (optimal) {
+		plannedBlockSizes = malloc(srcSize * sizeof(int));
+		plannedBlockDistances = malloc(srcSize * sizeof(int));
+
+		if (plannedBlockSizes == NULL || plannedBlockDistances == NULL)
+			goto fail;
+
+		if (!PlanOptimalParse(&finder, plannedBlockSizes, plannedBlockDistances))
+			goto fail;
+	}
+
 	// header
 	dest[0] = 0x10; // LZ compression type
 	dest[1] = (unsigned char)srcSize;
@@ -98,34 +285,22 @@ unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize,
 		*flags = 0;
 
 		for (int i = 0; i < 8; i++) {
-			int bestBlockDistance = 0;
-			int bestBlockSize = 0;
-			int blockDistance = minDistance;
-
-			while (blockDistance <= srcPos && blockDistance <= 0x1000) {
-				int blockStart = srcPos - blockDistance;
-				int blockSize = 0;
-
-				while (blockSize < 18
-				    && srcPos + blockSize < srcSize
-				    && src[blockStart + blockSize] == src[srcPos + blockSize])
-					blockSize++;
-
-				if (blockSize > bestBlockSize) {
-					bestBlockDistance = blockDistance;
-					bestBlockSize = blockSize;
-
-					if (blockSize == 18)
-						break;
-				}
-
-				blockDistance++;
+			int bestBlockDistance;
+			int bestBlockSize;
+
+			if (optimal) {
+				bestBlockSize = plannedBlockSizes[srcPos];
+				bestBlockDistance = plannedBlockDistances[srcPos];
+			} else if (fast) {
+				bestBlockSize = FindBestBlockHashChain(&finder, srcPos, &bestBlockDistance);
+			} else {
+				bestBlockSize = FindBestBlockBruteForce(&finder, srcPos, &bestBlockDistance);
 			}
 
-			if (bestBlockSize >= 3) {
+			if (bestBlockSize >= LZ_MIN_BLOCK_SIZE) {
 				*flags |= (0x80 >> i);
 				srcPos += bestBlockSize;
-				bestBlockSize -= 3;
+				bestBlockSize -= LZ_MIN_BLOCK_SIZE;
 				bestBlockDistance--;
 				dest[destPos++] = (bestBlockSize << 4) | ((unsigned int)bestBlockDistance >> 8);
 				dest[destPos++] = (unsigned char)bestBlockDistance;
@@ -142,6 +317,11 @@ unsigned char *LZCompress(unsigned char *src, int srcSize, int *compressedSize,
 						dest[destPos++] = 0;
 				}
 
+				free(finder.head);
+				free(finder.prev);
+				free(plannedBlockSizes);
+				free(plannedBlockDistances);
+
 				*compressedSize = destPos;
 				return dest;
 			}
@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "global.h"
 #include "util.h"
 #include "options.h"
@@ -13,6 +14,7 @@
 #include "rl.h"
 #include "font.h"
 #include "huff.h"
+#include "batch.h"
 
 struct CommandHandler
 {
@@ -21,6 +23,12 @@ struct CommandHandler
     void(*function)(char *inputPath, char *outputPath, int argc, char **argv);
 };
 
+// When set, -optimal LZ compressions also run the greedy parse so that the
+// total saving can be reported at the end of a batch.
+static bool sReportLZSavings = false;
+static atomic_long sLZBytesSaved;
+static atomic_int sNumLZOptimalFiles;
+
 void ConvertGbaToPng(char *inputPath, char *outputPath, struct GbaToPngOptions *options)
 {
     struct Image image;
@@ -429,6 +437,8 @@ void HandleLZCompressCommand(char *inputPath, char *outputPath, int argc, char *
 {
     int overflowSize = 0;
     int minDistance = 2; // default, for compatibility with LZ77UnCompVram()
+    bool fast = false;
+    bool optimal = false;
 
     for (int i = 3; i < argc; i++)
     {
@@ -460,6 +470,14 @@ void HandleLZCompressCommand(char *inputPath, char *outputPath, int argc, char *
             if (minDistance < 1)
                 FATAL_ERROR("LZ min search distance must be positive.\n");
         }
+        else if (strcmp(option, "-fast") == 0)
+        {
+            fast = true;
+        }
+        else if (strcmp(option, "-optimal") == 0)
+        {
+            optimal = true;
+        }
         else
         {
             FATAL_ERROR("Unrecognized option \"%s\".\n", option);
@@ -476,7 +494,15 @@ void HandleLZCompressCommand(char *inputPath, char *outputPath, int argc, char *
     unsigned char *buffer = ReadWholeFileZeroPadded(inputPath, &fileSize, overflowSize);
 
     int compressedSize;
-    unsigned char *compressedData = LZCompress(buffer, fileSize + overflowSize, &compressedSize, minDistance);
+    unsigned char *compressedData = LZCompress(buffer, fileSize + overflowSize, &compressedSize, minDistance, fast, optimal);
+
+    if (optimal && sReportLZSavings)
+    {
+        int greedySize;
+        free(LZCompress(buffer, fileSize + overflowSize, &greedySize, minDistance, true, false));
+        atomic_fetch_add(&sLZBytesSaved, greedySize - compressedSize);
+        atomic_fetch_add(&sNumLZOptimalFiles, 1);
+    }
 
     compressedData[1] = (unsigned char)fileSize;
     compressedData[2] = (unsigned char)(fileSize >> 8);
@@ -589,13 +615,10 @@ void HandleHuffDecompressCommand(char *inputPath, char *outputPath, int argc UNU
     free(uncompressedData);
 }
 
-int main(int argc, char **argv)
+static void ConvertFile(int argc, char **argv)
 {
     char converted = 0;
 
-    if (argc < 3)
-        FATAL_ERROR("Usage: gbagfx INPUT_PATH OUTPUT_PATH [options...]\n");
-
     struct CommandHandler handlers[] =
     {
         { "1bpp", "png", HandleGbaToPngCommand },
@@ -675,6 +698,53 @@ int main(int argc, char **argv)
 
     if (!converted)
         FATAL_ERROR("Don't know how to convert \"%s\" to \"%s\".\n", argv[1], argv[2]);
+}
+
+void HandleBatchCommand(int argc, char **argv)
+{
+    int numThreads = GetDefaultBatchThreadCount();
+
+    for (int i = 3; i < argc; i++)
+    {
+        char *option = argv[i];
+
+        if (strcmp(option, "-j") == 0)
+        {
+            if (i + 1 >= argc)
+                FATAL_ERROR("No thread count following \"-j\".\n");
+
+            i++;
+
+            if (!ParseNumber(argv[i], NULL, 10, &numThreads))
+                FATAL_ERROR("Failed to parse thread count.\n");
+
+            if (numThreads < 1)
+                FATAL_ERROR("Thread count must be positive.\n");
+        }
+        else
+        {
+            FATAL_ERROR("Unrecognized option \"%s\".\n", option);
+        }
+    }
+
+    sReportLZSavings = true;
+
+    RunBatch(argv[2], numThreads, ConvertFile);
+
+    if (sNumLZOptimalFiles > 0)
+        printf("gbagfx: -optimal saved %ld bytes over the greedy parse across %d LZ files.\n", (long)sLZBytesSaved, (int)sNumLZOptimalFiles);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+        FATAL_ERROR("Usage: gbagfx INPUT_PATH OUTPUT_PATH [options...]\n"
+                    "       gbagfx -batch MANIFEST_PATH [-j THREADS]\n");
+
+    if (strcmp(argv[1], "-batch") == 0)
+        HandleBatchCommand(argc, argv);
+    else
+        ConvertFile(argc, argv);
 
     return 0;
 }
@@ -209,6 +209,37 @@ string generate_map_connections_text(Json map_data) {
     return text.str();
 }
 
+// Writes the indices of a map's warp, coord or bg events sorted by y, then x, so the
+// game can binary search for the events on a tile. Events on the same tile keep their
+// order from map.json, which decides which one the game finds first. If a position
+// isn't a plain number the list is left out and the game scans the events instead.
+string generate_event_position_order_text(ostringstream &text, const Json::array &events, string label) {
+    if (events.empty() || events.size() > 0xFF)
+        return "NULL";
+
+    vector<unsigned int> order;
+    for (unsigned int i = 0; i < events.size(); i++) {
+        if (!events[i]["x"].is_number() || !events[i]["y"].is_number())
+            return "NULL";
+        order.push_back(i);
+    }
+
+    // Matches how the game compares positions, as (u16)y then (u16)x.
+    auto position_key = [&events](unsigned int i) {
+        return ((unsigned int)(events[i]["y"].int_value() & 0xFFFF) << 16) | (unsigned int)(events[i]["x"].int_value() & 0xFFFF);
+    };
+    std::stable_sort(order.begin(), order.end(), [&position_key](unsigned int a, unsigned int b) {
+        return position_key(a) < position_key(b);
+    });
+
+    text << label << ":\n\t.byte ";
+    for (unsigned int i = 0; i < order.size(); i++)
+        text << (i > 0 ? ", " : "") << order[i];
+    text << "\n\n";
+
+    return label;
+}
+
 string generate_map_events_text(Json map_data) {
     if (map_data.object_items().find("shared_events_map") != map_data.object_items().end())
         return string("\n");
@@ -345,9 +376,15 @@ string generate_map_events_text(Json map_data) {
         bgs_label = "NULL";
     }
 
-    text << mapName << "_MapEvents::\n"
+    string warps_order_label = generate_event_position_order_text(text, map_data["warp_events"].array_items(), mapName + "_MapWarpsByPosition");
+    string coords_order_label = generate_event_position_order_text(text, map_data["coord_events"].array_items(), mapName + "_MapCoordEventsByPosition");
+    string bgs_order_label = generate_event_position_order_text(text, map_data["bg_events"].array_items(), mapName + "_MapBGEventsByPosition");
+
+    text << "\t.align 2\n"
+         << mapName << "_MapEvents::\n"
          << "\tmap_events " << objects_label << ", " << warps_label << ", "
-         << coords_label << ", " << bgs_label << "\n\n";
+         << coords_label << ", " << bgs_label << ", "
+         << warps_order_label << ", " << coords_order_label << ", " << bgs_order_label << "\n\n";
 
     return text.str();
 }
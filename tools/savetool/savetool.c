@@ -0,0 +1,709 @@
+// savetool: checks .sav files and prints what's in them.
+//
+//   savetool pokeemerald.sav          report on one save
+//   savetool -j 8 saves/*.sav         one line per save, 8 at a time
+//   find saves -name '*.sav' | savetool -j 8 -
+//
+// Each save slot is checked the way the game checks it when loading (see
+// GetSaveValidStatus in src/save.c), and the newest good slot is decoded. The
+// structs come from the game's headers, so rebuild the tool after changing
+// anything that is saved.
+//
+// The exit status is 1 if any save failed to load or has a damaged slot.
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "global.h"
+#include "pokemon.h"
+#include "pokemon_storage_system.h"
+#include "save.h"
+#include "constants/characters.h"
+
+#define FATAL_ERROR(format, ...)          \
+do                                        \
+{                                         \
+    fprintf(stderr, format, ##__VA_ARGS__); \
+    exit(1);                              \
+} while (0)
+
+// Every pointer in a saved struct is 4 bytes on the GBA but 8 on a 64-bit
+// host. SaveBlock2, PokemonStorage and Pokemon don't have any, so they are
+// read through the game's structs as they are. SaveBlock1 does, starting with
+// ObjectEventTemplate's script, so members after objectEventTemplates are
+// moved back by the difference.
+#define GBA_OBJECT_EVENT_TEMPLATE_SIZE 0x18
+#define SAVEBLOCK1_PADDING (OBJECT_EVENT_TEMPLATES_COUNT * (sizeof(struct ObjectEventTemplate) - GBA_OBJECT_EVENT_TEMPLATE_SIZE))
+#define SAVEBLOCK1_OFFSET(member) (offsetof(struct SaveBlock1, member) - (offsetof(struct SaveBlock1, member) > offsetof(struct SaveBlock1, objectEventTemplates) ? SAVEBLOCK1_PADDING : 0))
+
+STATIC_ASSERT(sizeof(struct ObjectEventTemplate) == GBA_OBJECT_EVENT_TEMPLATE_SIZE + 2 * (sizeof(void *) - 4), ObjectEventTemplateHasOnePointer);
+STATIC_ASSERT(offsetof(struct SaveBlock1, flags) == offsetof(struct SaveBlock1, objectEventTemplates) + sizeof(((struct SaveBlock1 *)0)->objectEventTemplates), FlagsFollowObjectEventTemplates);
+STATIC_ASSERT(sizeof(struct BoxPokemon) == 80, BoxPokemonSize);
+STATIC_ASSERT(sizeof(struct Pokemon) == 100, PokemonSize);
+STATIC_ASSERT(sizeof(struct SaveSector) == SECTOR_SIZE, SaveSectorSize);
+
+#define SAVE_FILE_SIZE (SECTORS_COUNT * SECTOR_SIZE)
+#define NUM_SAVEBLOCK1_SECTORS (SECTOR_ID_SAVEBLOCK1_END - SECTOR_ID_SAVEBLOCK1_START + 1)
+#define NUM_PKMN_STORAGE_SECTORS (SECTOR_ID_PKMN_STORAGE_END - SECTOR_ID_PKMN_STORAGE_START + 1)
+
+enum
+{
+    SLOT_EMPTY,
+    SLOT_OK,
+    SLOT_DAMAGED,
+};
+
+static const char *const sSlotStatusNames[] = {"empty", "OK", "damaged"};
+
+struct SaveSlot
+{
+    int status;
+    u32 counter;
+    int rotation; // Which sector holds SaveBlock2, -1 if none does
+    u32 validIds;
+    bool torn;
+    const struct SaveSector *sectors[NUM_SECTORS_PER_SLOT]; // By sector id
+};
+
+struct SaveFile
+{
+    const char *path;
+    const u8 *data;
+    size_t size;
+    struct SaveSlot slots[NUM_SAVE_SLOTS];
+    int loadedSlot; // -1 if neither slot can be loaded
+    u8 status; // SAVE_STATUS_*, as LoadGameSave would set gSaveFileStatus
+
+    // The loaded slot's data, put back together from its sectors.
+    u8 saveBlock2[SECTOR_DATA_SIZE];
+    u8 saveBlock1[NUM_SAVEBLOCK1_SECTORS * SECTOR_DATA_SIZE];
+    u8 storage[NUM_PKMN_STORAGE_SECTORS * SECTOR_DATA_SIZE];
+};
+
+struct PcSummary
+{
+    int numMons;
+    int numBadMons;
+    int numBoxesUsed;
+};
+
+static const u8 sSubstructOrders[24][4] =
+{
+    {0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 1, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {0, 3, 2, 1},
+    {1, 0, 2, 3}, {1, 0, 3, 2}, {2, 0, 1, 3}, {3, 0, 1, 2}, {2, 0, 3, 1}, {3, 0, 2, 1},
+    {1, 2, 0, 3}, {1, 3, 0, 2}, {2, 1, 0, 3}, {3, 1, 0, 2}, {2, 3, 0, 1}, {3, 2, 0, 1},
+    {1, 2, 3, 0}, {1, 3, 2, 0}, {2, 1, 3, 0}, {3, 1, 2, 0}, {2, 3, 1, 0}, {3, 2, 1, 0},
+};
+
+static u32 ReadU32(const void *src)
+{
+    const u8 *bytes = src;
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((u32)bytes[3] << 24);
+}
+
+// Same sum as CalculateChecksum in src/save.c. The game sums only the bytes
+// the sector's data needs, but it zeroes the rest of the sector before
+// writing it, so summing the whole data area gives the same result without
+// knowing how big each GBA struct is.
+static u16 CalculateChecksum(const u8 *data, u32 size)
+{
+    u32 checksum = 0;
+    u32 i;
+
+    for (i = 0; i + 4 <= size; i += 4)
+        checksum += ReadU32(data + i);
+
+    return (checksum >> 16) + checksum;
+}
+
+static bool IsSectorValid(const struct SaveSector *sector)
+{
+    return sector->signature == SECTOR_SIGNATURE
+        && sector->id < NUM_SECTORS_PER_SLOT
+        && sector->checksum == CalculateChecksum(sector->data, SECTOR_DATA_SIZE);
+}
+
+static void CheckSaveSlot(struct SaveFile *save, int slotId)
+{
+    struct SaveSlot *slot = &save->slots[slotId];
+    const struct SaveSector *sectors = (const struct SaveSector *)save->data + slotId * NUM_SECTORS_PER_SLOT;
+    bool signatureValid = false;
+    u32 newestCounter = 0;
+    int i;
+
+    memset(slot, 0, sizeof(*slot));
+    slot->rotation = -1;
+
+    for (i = 0; i < NUM_SECTORS_PER_SLOT; i++)
+    {
+        const struct SaveSector *sector = &sectors[i];
+
+        if (sector->signature != SECTOR_SIGNATURE)
+            continue;
+        signatureValid = true;
+        if (!IsSectorValid(sector))
+            continue;
+
+        if (sector->id == SECTOR_ID_SAVEBLOCK2)
+        {
+            slot->counter = sector->counter;
+            slot->rotation = i;
+        }
+        if (slot->validIds == 0 || (s32)(sector->counter - newestCounter) > 0)
+            newestCounter = sector->counter;
+        slot->validIds |= 1 << sector->id;
+        slot->sectors[sector->id] = sector;
+    }
+
+    if (!signatureValid)
+    {
+        slot->status = SLOT_EMPTY;
+    }
+    else if (slot->validIds == (1 << NUM_SECTORS_PER_SLOT) - 1)
+    {
+        // A sector newer than SaveBlock2 means a save was interrupted
+        slot->torn = newestCounter != slot->counter;
+        slot->status = slot->torn ? SLOT_DAMAGED : SLOT_OK;
+    }
+    else
+    {
+        slot->status = SLOT_DAMAGED;
+    }
+}
+
+// Picks the slot to load like GetSaveValidStatus does.
+static void ChooseSaveSlot(struct SaveFile *save)
+{
+    const struct SaveSlot *slot1 = &save->slots[0];
+    const struct SaveSlot *slot2 = &save->slots[1];
+
+    if (slot1->status == SLOT_OK && slot2->status == SLOT_OK)
+    {
+        if ((slot1->counter == (u32)-1 && slot2->counter == 0)
+         || (slot1->counter == 0 && slot2->counter == (u32)-1))
+            save->loadedSlot = slot1->counter + 1 < slot2->counter + 1 ? 1 : 0;
+        else
+            save->loadedSlot = slot1->counter < slot2->counter ? 1 : 0;
+        save->status = SAVE_STATUS_OK;
+    }
+    else if (slot1->status == SLOT_OK)
+    {
+        save->loadedSlot = 0;
+        save->status = slot2->status == SLOT_DAMAGED ? SAVE_STATUS_ERROR : SAVE_STATUS_OK;
+    }
+    else if (slot2->status == SLOT_OK)
+    {
+        save->loadedSlot = 1;
+        save->status = slot1->status == SLOT_DAMAGED ? SAVE_STATUS_ERROR : SAVE_STATUS_OK;
+    }
+    else
+    {
+        save->loadedSlot = -1;
+        if (slot1->status == SLOT_EMPTY && slot2->status == SLOT_EMPTY)
+            save->status = SAVE_STATUS_EMPTY;
+        else
+            save->status = SAVE_STATUS_CORRUPT;
+    }
+}
+
+static void LoadSaveSlot(struct SaveFile *save)
+{
+    const struct SaveSlot *slot = &save->slots[save->loadedSlot];
+    int i;
+
+    memcpy(save->saveBlock2, slot->sectors[SECTOR_ID_SAVEBLOCK2]->data, SECTOR_DATA_SIZE);
+    for (i = 0; i < NUM_SAVEBLOCK1_SECTORS; i++)
+        memcpy(save->saveBlock1 + i * SECTOR_DATA_SIZE, slot->sectors[SECTOR_ID_SAVEBLOCK1_START + i]->data, SECTOR_DATA_SIZE);
+    for (i = 0; i < NUM_PKMN_STORAGE_SECTORS; i++)
+        memcpy(save->storage + i * SECTOR_DATA_SIZE, slot->sectors[SECTOR_ID_PKMN_STORAGE_START + i]->data, SECTOR_DATA_SIZE);
+}
+
+static const char *GetSaveStatusName(u8 status)
+{
+    switch (status)
+    {
+    case SAVE_STATUS_EMPTY:
+        return "empty";
+    case SAVE_STATUS_OK:
+        return "ok";
+    case SAVE_STATUS_CORRUPT:
+        return "corrupt";
+    case SAVE_STATUS_ERROR:
+    default:
+        return "error";
+    }
+}
+
+// Converts game text to ASCII. Characters without an ASCII equivalent become '?'.
+static void DecodeText(char *dest, const u8 *src, int length)
+{
+    int i;
+
+    for (i = 0; i < length && src[i] != EOS; i++)
+    {
+        u8 c = src[i];
+
+        if (c == 0x00)
+            dest[i] = ' ';
+        else if (c >= 0xA1 && c <= 0xAA)
+            dest[i] = '0' + c - 0xA1;
+        else if (c >= 0xBB && c <= 0xD4)
+            dest[i] = 'A' + c - 0xBB;
+        else if (c >= 0xD5 && c <= 0xEE)
+            dest[i] = 'a' + c - 0xD5;
+        else if (c == 0xAB)
+            dest[i] = '!';
+        else if (c == 0xAC)
+            dest[i] = '?';
+        else if (c == 0xAD)
+            dest[i] = '.';
+        else if (c == 0xAE)
+            dest[i] = '-';
+        else
+            dest[i] = '?';
+    }
+    dest[i] = '\0';
+}
+
+// Decrypts a copy of a box mon's substructs, like DecryptBoxMon in src/pokemon.c.
+// Returns false if the checksum is wrong, which the game treats as a Bad Egg.
+static bool DecryptBoxMon(const struct BoxPokemon *boxMon, union PokemonSubstruct substructs[4])
+{
+    union PokemonSubstruct raw[4];
+    const u8 *order = sSubstructOrders[boxMon->personality % 24];
+    u16 checksum = 0;
+    int i;
+
+    memcpy(raw, boxMon->secure.substructs, sizeof(raw));
+    for (i = 0; i < (int)ARRAY_COUNT(boxMon->secure.raw); i++)
+        ((u32 *)raw)[i] ^= boxMon->otId ^ boxMon->personality;
+    for (i = 0; i < (int)ARRAY_COUNT(boxMon->secure.raw) * 2; i++)
+        checksum += ((u16 *)raw)[i];
+
+    for (i = 0; i < 4; i++)
+        substructs[i] = raw[order[i]];
+
+    return checksum == boxMon->checksum;
+}
+
+static bool GetFlag(const struct SaveFile *save, u16 flag)
+{
+    const u8 *flags = save->saveBlock1 + SAVEBLOCK1_OFFSET(flags);
+    return (flags[flag / 8] >> (flag % 8)) & 1;
+}
+
+static int CountDexFlags(const u8 *flags)
+{
+    int count = 0;
+    int i;
+
+    for (i = 0; i < NATIONAL_DEX_COUNT; i++)
+    {
+        if ((flags[i / 8] >> (i % 8)) & 1)
+            count++;
+    }
+    return count;
+}
+
+static int CountBadges(const struct SaveFile *save)
+{
+    int count = 0;
+    u16 flag;
+
+    for (flag = FLAG_BADGE01_GET; flag <= FLAG_BADGE08_GET; flag++)
+    {
+        if (GetFlag(save, flag))
+            count++;
+    }
+    return count;
+}
+
+static void SummarizePc(const struct SaveFile *save, struct PcSummary *pc, FILE *badMonsOutput)
+{
+    const struct PokemonStorage *storage = (const struct PokemonStorage *)save->storage;
+    int boxId, position;
+
+    memset(pc, 0, sizeof(*pc));
+    for (boxId = 0; boxId < TOTAL_BOXES_COUNT; boxId++)
+    {
+        int numInBox = 0;
+
+        for (position = 0; position < IN_BOX_COUNT; position++)
+        {
+            union PokemonSubstruct substructs[4];
+
+            if (!DecryptBoxMon(&storage->boxes[boxId][position], substructs))
+            {
+                pc->numBadMons++;
+                if (badMonsOutput != NULL)
+                    fprintf(badMonsOutput, "    Bad checksum: box %d, slot %d\n", boxId + 1, position + 1);
+            }
+            else if (substructs[0].type0.species != SPECIES_NONE)
+            {
+                numInBox++;
+            }
+        }
+        pc->numMons += numInBox;
+        if (numInBox != 0)
+            pc->numBoxesUsed++;
+    }
+}
+
+static void PrintSlot(FILE *out, const struct SaveFile *save, int slotId)
+{
+    const struct SaveSlot *slot = &save->slots[slotId];
+    int id;
+
+    fprintf(out, "  Slot %d: %s", slotId + 1, sSlotStatusNames[slot->status]);
+    if (slot->status == SLOT_EMPTY)
+    {
+        fprintf(out, "\n");
+        return;
+    }
+    if (slot->rotation >= 0)
+        fprintf(out, ", save %u, SaveBlock2 in sector %d", slot->counter, slot->rotation);
+    if (slot->torn)
+        fprintf(out, ", interrupted while saving");
+    fprintf(out, "\n");
+
+    if (slot->validIds != (1 << NUM_SECTORS_PER_SLOT) - 1)
+    {
+        fprintf(out, "    Missing or bad sector ids:");
+        for (id = 0; id < NUM_SECTORS_PER_SLOT; id++)
+        {
+            if (!(slot->validIds & (1 << id)))
+                fprintf(out, " %d", id);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+static void PrintSpecialSectors(FILE *out, const struct SaveFile *save)
+{
+    const struct SaveSector *sectors = (const struct SaveSector *)save->data;
+    int i;
+    bool hofValid = true;
+    bool hofEmpty = true;
+
+    // Hall of Fame sectors keep their checksum in the id field (see HandleWriteSectorNBytes)
+    for (i = SECTOR_ID_HOF_1; i < SECTOR_ID_HOF_1 + NUM_HOF_SECTORS; i++)
+    {
+        if (sectors[i].signature != SECTOR_SIGNATURE)
+        {
+            hofValid = false;
+            continue;
+        }
+        hofEmpty = false;
+        if (sectors[i].id != CalculateChecksum(sectors[i].data, SECTOR_DATA_SIZE))
+            hofValid = false;
+    }
+    fprintf(out, "  Hall of Fame: %s\n", hofEmpty ? "empty" : hofValid ? "OK" : "damaged");
+
+    fprintf(out, "  Trainer Hill: %s\n", ReadU32(sectors[SECTOR_ID_TRAINER_HILL].data) == SPECIAL_SECTOR_SENTINEL ? "saved" : "empty");
+    fprintf(out, "  Recorded Battle: %s\n", ReadU32(sectors[SECTOR_ID_RECORDED_BATTLE].data) == SPECIAL_SECTOR_SENTINEL ? "saved" : "empty");
+}
+
+static void PrintReport(FILE *out, const struct SaveFile *save)
+{
+    const struct SaveBlock2 *saveBlock2 = (const struct SaveBlock2 *)save->saveBlock2;
+    const struct SaveBlock1 *saveBlock1 = (const struct SaveBlock1 *)save->saveBlock1;
+    struct PcSummary pc;
+    char name[POKEMON_NAME_LENGTH + 1];
+    int i;
+
+    fprintf(out, "%s: %s\n", save->path, GetSaveStatusName(save->status));
+    for (i = 0; i < NUM_SAVE_SLOTS; i++)
+        PrintSlot(out, save, i);
+    PrintSpecialSectors(out, save);
+
+    if (save->loadedSlot < 0)
+        return;
+
+    fprintf(out, "\n  Loaded slot %d (save %u)\n", save->loadedSlot + 1, save->slots[save->loadedSlot].counter);
+
+    DecodeText(name, saveBlock2->playerName, PLAYER_NAME_LENGTH);
+    fprintf(out, "  Player: %s (%s), ID %05u, secret ID %05u\n", name,
+            saveBlock2->playerGender == MALE ? "male" : "female",
+            saveBlock2->playerTrainerId[0] | (saveBlock2->playerTrainerId[1] << 8),
+            saveBlock2->playerTrainerId[2] | (saveBlock2->playerTrainerId[3] << 8));
+    fprintf(out, "  Play time: %u:%02u:%02u\n", saveBlock2->playTimeHours, saveBlock2->playTimeMinutes, saveBlock2->playTimeSeconds);
+    fprintf(out, "  Location: map group %d, map %d (%d, %d)\n", saveBlock1->location.mapGroup, saveBlock1->location.mapNum, saveBlock1->pos.x, saveBlock1->pos.y);
+    fprintf(out, "  Money: %u, coins: %u\n", saveBlock1->money ^ saveBlock2->encryptionKey, (u16)(saveBlock1->coins ^ saveBlock2->encryptionKey));
+    fprintf(out, "  Badges: %d\n", CountBadges(save));
+    fprintf(out, "  Pokédex: %d seen, %d owned\n", CountDexFlags(saveBlock2->pokedex.seen), CountDexFlags(saveBlock2->pokedex.owned));
+
+    fprintf(out, "  Party: %d\n", saveBlock1->playerPartyCount);
+    for (i = 0; i < saveBlock1->playerPartyCount && i < PARTY_SIZE; i++)
+    {
+        const struct Pokemon *mon = &saveBlock1->playerParty[i];
+        union PokemonSubstruct substructs[4];
+
+        DecodeText(name, mon->box.nickname, POKEMON_NAME_LENGTH);
+        if (!DecryptBoxMon(&mon->box, substructs))
+            fprintf(out, "    %d. %-10s  bad checksum\n", i + 1, name);
+        else
+            fprintf(out, "    %d. %-10s  species %3u, Lv. %3u%s\n", i + 1, name, substructs[0].type0.species, mon->level, substructs[3].type3.isEgg ? ", egg" : "");
+    }
+
+    SummarizePc(save, &pc, NULL);
+    fprintf(out, "  PC: %d Pokémon in %d boxes, current box %d\n", pc.numMons, pc.numBoxesUsed, ((const struct PokemonStorage *)save->storage)->currentBox + 1);
+    if (pc.numBadMons != 0)
+        SummarizePc(save, &pc, out);
+}
+
+// One tab-separated line per save for batch runs:
+// path, status, loaded slot, save counter, player, play time, badges, party, PC mons, bad PC mons
+static void PrintSummaryLine(FILE *out, const struct SaveFile *save)
+{
+    const struct SaveBlock2 *saveBlock2 = (const struct SaveBlock2 *)save->saveBlock2;
+    const struct SaveBlock1 *saveBlock1 = (const struct SaveBlock1 *)save->saveBlock1;
+    struct PcSummary pc;
+    char name[PLAYER_NAME_LENGTH + 1];
+
+    if (save->loadedSlot < 0)
+    {
+        fprintf(out, "%s\t%s\n", save->path, GetSaveStatusName(save->status));
+        return;
+    }
+
+    SummarizePc(save, &pc, NULL);
+    DecodeText(name, saveBlock2->playerName, PLAYER_NAME_LENGTH);
+    fprintf(out, "%s\t%s\t%d\t%u\t%s\t%u:%02u:%02u\t%d\t%d\t%d\t%d\n",
+            save->path, GetSaveStatusName(save->status),
+            save->loadedSlot + 1, save->slots[save->loadedSlot].counter, name,
+            saveBlock2->playTimeHours, saveBlock2->playTimeMinutes, saveBlock2->playTimeSeconds,
+            CountBadges(save), saveBlock1->playerPartyCount, pc.numMons, pc.numBadMons);
+}
+
+// Saves are only read, so mapping them lets many be checked at once without
+// copying each one.
+static const u8 *MapFile(const char *path, size_t *size)
+{
+    struct stat st;
+    void *data;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return NULL;
+    }
+    *size = st.st_size;
+    data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    return data == MAP_FAILED ? NULL : data;
+}
+
+static void UnmapFile(const u8 *data, size_t size)
+{
+    munmap((void *)data, size);
+}
+
+// Returns a malloc'd string with what to print for the save, and whether it
+// loaded without problems.
+static char *ProcessSave(const char *path, bool summaryOnly, bool *ok)
+{
+    struct SaveFile *save = calloc(1, sizeof(*save));
+    char *output = NULL;
+    size_t outputSize = 0;
+    FILE *out = open_memstream(&output, &outputSize);
+    int i;
+
+    if (save == NULL || out == NULL)
+        FATAL_ERROR("Out of memory\n");
+
+    save->path = path;
+    save->data = MapFile(path, &save->size);
+    if (save->data == NULL)
+    {
+        fprintf(out, summaryOnly ? "%s\tunreadable\t%s\n" : "%s: can't read (%s)\n", path, strerror(errno));
+        *ok = false;
+    }
+    else if (save->size < SAVE_FILE_SIZE)
+    {
+        fprintf(out, summaryOnly ? "%s\ttoo-small\t%zu\n" : "%s: only %zu bytes, a save is 128 KiB\n", path, save->size);
+        *ok = false;
+    }
+    else
+    {
+        for (i = 0; i < NUM_SAVE_SLOTS; i++)
+            CheckSaveSlot(save, i);
+        ChooseSaveSlot(save);
+        if (save->loadedSlot >= 0)
+            LoadSaveSlot(save);
+
+        if (summaryOnly)
+            PrintSummaryLine(out, save);
+        else
+            PrintReport(out, save);
+        *ok = save->status == SAVE_STATUS_OK;
+    }
+
+    if (save->data != NULL)
+        UnmapFile(save->data, save->size);
+    fclose(out);
+    free(save);
+    return output;
+}
+
+struct Batch
+{
+    char **paths;
+    int numPaths;
+    bool summaryOnly;
+
+    pthread_mutex_t mutex;
+    int nextPath;
+    // Results are printed in the order the saves were given, as soon as all
+    // the ones before them are done.
+    char **outputs;
+    int nextOutput;
+    int numFailed;
+};
+
+static void *BatchWorker(void *arg)
+{
+    struct Batch *batch = arg;
+
+    for (;;)
+    {
+        int index;
+        char *output;
+        bool ok;
+
+        pthread_mutex_lock(&batch->mutex);
+        index = batch->nextPath++;
+        pthread_mutex_unlock(&batch->mutex);
+        if (index >= batch->numPaths)
+            break;
+
+        output = ProcessSave(batch->paths[index], batch->summaryOnly, &ok);
+
+        pthread_mutex_lock(&batch->mutex);
+        if (!ok)
+            batch->numFailed++;
+        batch->outputs[index] = output;
+        while (batch->nextOutput < batch->numPaths && batch->outputs[batch->nextOutput] != NULL)
+        {
+            fputs(batch->outputs[batch->nextOutput], stdout);
+            free(batch->outputs[batch->nextOutput]);
+            batch->outputs[batch->nextOutput] = NULL;
+            batch->nextOutput++;
+        }
+        fflush(stdout);
+        pthread_mutex_unlock(&batch->mutex);
+    }
+
+    return NULL;
+}
+
+// Reads one path per line.
+static void ReadPathList(FILE *fp, char ***paths, int *numPaths)
+{
+    char *line = NULL;
+    size_t lineSize = 0;
+    ssize_t length;
+    int capacity = *numPaths;
+
+    while ((length = getline(&line, &lineSize, fp)) >= 0)
+    {
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+            line[--length] = '\0';
+        if (length == 0)
+            continue;
+
+        if (*numPaths == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 256;
+            *paths = realloc(*paths, capacity * sizeof(**paths));
+            if (*paths == NULL)
+                FATAL_ERROR("Out of memory\n");
+        }
+        (*paths)[(*numPaths)++] = strdup(line);
+    }
+    free(line);
+}
+
+static const char *const USAGE =
+    "Usage: savetool [-j JOBS] [-s] SAVE_FILE...\n"
+    "A SAVE_FILE of - reads the paths of the saves from stdin, one per line.\n"
+    "With more than one save, or with -s, prints one tab-separated line per save.\n";
+
+int main(int argc, char **argv)
+{
+    struct Batch batch;
+    pthread_t *threads;
+    int numJobs = 1;
+    bool forceSummary = false;
+    int i;
+
+    memset(&batch, 0, sizeof(batch));
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            numJobs = atoi(argv[++i]);
+            if (numJobs < 1)
+                FATAL_ERROR("-j needs a positive number\n");
+        }
+        else if (strcmp(argv[i], "-s") == 0)
+        {
+            forceSummary = true;
+        }
+        else if (strcmp(argv[i], "-") == 0)
+        {
+            ReadPathList(stdin, &batch.paths, &batch.numPaths);
+        }
+        else if (argv[i][0] == '-')
+        {
+            FATAL_ERROR("%s", USAGE);
+        }
+        else
+        {
+            batch.paths = realloc(batch.paths, (batch.numPaths + 1) * sizeof(*batch.paths));
+            if (batch.paths == NULL)
+                FATAL_ERROR("Out of memory\n");
+            batch.paths[batch.numPaths++] = argv[i];
+        }
+    }
+
+    if (batch.numPaths == 0)
+        FATAL_ERROR("%s", USAGE);
+
+    batch.summaryOnly = forceSummary || batch.numPaths > 1;
+    batch.outputs = calloc(batch.numPaths, sizeof(*batch.outputs));
+    if (batch.outputs == NULL)
+        FATAL_ERROR("Out of memory\n");
+    pthread_mutex_init(&batch.mutex, NULL);
+
+    if (numJobs > batch.numPaths)
+        numJobs = batch.numPaths;
+    threads = malloc(numJobs * sizeof(*threads));
+    if (threads == NULL)
+        FATAL_ERROR("Out of memory\n");
+    for (i = 0; i < numJobs; i++)
+    {
+        if (pthread_create(&threads[i], NULL, BatchWorker, &batch) != 0)
+            FATAL_ERROR("Failed to start worker thread\n");
+    }
+    for (i = 0; i < numJobs; i++)
+        pthread_join(threads[i], NULL);
+
+    if (batch.numPaths > 1)
+        fprintf(stderr, "%d of %d saves OK\n", batch.numPaths - batch.numFailed, batch.numPaths);
+
+    return batch.numFailed != 0;
+}
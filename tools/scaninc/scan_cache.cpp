@@ -0,0 +1,161 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include "scaninc.h"
+#include "source_file.h"
+#include "scan_cache.h"
+
+// Cache file format, one record per line:
+//   scaninc-cache <version>
+//   F <mtime> <size> <path>
+//   I <include path>      (belongs to the preceding F record)
+//   B <incbin path>       (belongs to the preceding F record)
+static const char *const CACHE_HEADER = "scaninc-cache 1";
+
+static bool GetFileStamp(const std::string& path, int64_t& mtime, uintmax_t& size)
+{
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(path, error);
+    if (error)
+        return false;
+    size = std::filesystem::file_size(path, error);
+    if (error)
+        return false;
+    mtime = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+bool ScanCache::ReadEntries(const std::string& path, std::map<std::string, Entry>& entries)
+{
+    std::ifstream input(path);
+    std::string line;
+
+    if (!input || !std::getline(input, line) || line != CACHE_HEADER)
+        return false;
+
+    Entry *entry = nullptr;
+
+    while (std::getline(input, line))
+    {
+        if (line.size() < 2 || line[1] != ' ')
+            return false;
+
+        std::string value = line.substr(2);
+
+        if (line[0] == 'F')
+        {
+            std::size_t mtimeEnd = value.find(' ');
+            std::size_t sizeEnd = mtimeEnd == std::string::npos ? std::string::npos : value.find(' ', mtimeEnd + 1);
+            if (sizeEnd == std::string::npos)
+                return false;
+
+            entry = &entries[value.substr(sizeEnd + 1)];
+            entry->mtime = std::stoll(value.substr(0, mtimeEnd));
+            entry->size = std::stoull(value.substr(mtimeEnd + 1, sizeEnd - mtimeEnd - 1));
+            entry->file = ScannedFile();
+        }
+        else if (line[0] == 'I' && entry != nullptr)
+        {
+            entry->file.includes.insert(value);
+        }
+        else if (line[0] == 'B' && entry != nullptr)
+        {
+            entry->file.incbins.insert(value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ScanCache::Load(const std::string& path)
+{
+    if (!ReadEntries(path, m_entries))
+        m_entries.clear();
+}
+
+void ScanCache::Save(const std::string& path)
+{
+    if (!m_dirty)
+        return;
+
+    // Other scaninc processes may have saved since this one loaded, so merge
+    // with what is on disk now. The rename keeps readers from seeing a
+    // partially written file.
+    std::map<std::string, Entry> entries;
+    if (!ReadEntries(path, entries))
+        entries.clear();
+    for (const auto& validated : m_validated)
+        entries[validated.first] = *validated.second;
+
+    std::string tempPath = path + ".tmp" + std::to_string(std::random_device()());
+    {
+        std::ofstream output(tempPath);
+        if (!output)
+            return;
+
+        output << CACHE_HEADER << '\n';
+        for (const auto& entry : entries)
+        {
+            output << "F " << entry.second.mtime << ' ' << entry.second.size << ' ' << entry.first << '\n';
+            for (const std::string& include : entry.second.file.includes)
+                output << "I " << include << '\n';
+            for (const std::string& incbin : entry.second.file.incbins)
+                output << "B " << incbin << '\n';
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+        std::filesystem::remove(tempPath, error);
+}
+
+const ScannedFile& ScanCache::Scan(const std::string& path)
+{
+    auto validated = m_validated.find(path);
+    if (validated != m_validated.end())
+        return validated->second->file;
+
+    int64_t mtime = 0;
+    uintmax_t size = 0;
+    bool hasStamp = GetFileStamp(path, mtime, size);
+
+    auto cached = m_entries.find(path);
+    if (hasStamp && cached != m_entries.end() && cached->second.mtime == mtime && cached->second.size == size)
+    {
+        m_validated[path] = &cached->second;
+        return cached->second.file;
+    }
+
+    SourceFile source(path);
+    Entry& entry = m_entries[path];
+    entry.mtime = mtime;
+    entry.size = size;
+    entry.file.includes = source.GetIncludes();
+    entry.file.incbins = source.GetIncbins();
+    m_validated[path] = &entry;
+    m_dirty = true;
+    return entry.file;
+}
+
+bool ScanCache::CanOpenFile(const std::string& path)
+{
+    auto openable = m_openable.find(path);
+    if (openable != m_openable.end())
+        return openable->second;
+
+    FILE *fp = std::fopen(path.c_str(), "rb");
+    bool canOpen = fp != NULL;
+
+    if (canOpen)
+        std::fclose(fp);
+
+    m_openable[path] = canOpen;
+    return canOpen;
+}
@@ -0,0 +1,43 @@
+#ifndef SCAN_CACHE_H
+#define SCAN_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+struct ScannedFile
+{
+    std::set<std::string> includes;
+    std::set<std::string> incbins;
+};
+
+// Remembers the includes and incbins of every scanned file, keyed by path and
+// validated against the file's modification time and size. Entries live for
+// the whole process and can be persisted to disk so later runs skip parsing
+// files that have not changed.
+class ScanCache
+{
+public:
+    void Load(const std::string& path);
+    void Save(const std::string& path);
+    const ScannedFile& Scan(const std::string& path);
+    bool CanOpenFile(const std::string& path);
+
+private:
+    struct Entry
+    {
+        int64_t mtime;
+        uintmax_t size;
+        ScannedFile file;
+    };
+
+    std::map<std::string, Entry> m_entries;
+    std::map<std::string, Entry *> m_validated;
+    std::map<std::string, bool> m_openable;
+    bool m_dirty = false;
+
+    static bool ReadEntries(const std::string& path, std::map<std::string, Entry>& entries);
+};
+
+#endif // SCAN_CACHE_H
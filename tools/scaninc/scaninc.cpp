@@ -29,103 +29,54 @@
 #include <fstream>
 #include "scaninc.h"
 #include "source_file.h"
+#include "scan_cache.h"
 
-bool CanOpenFile(std::string path)
-{
-    FILE *fp = std::fopen(path.c_str(), "rb");
-
-    if (fp == NULL)
-        return false;
-
-    std::fclose(fp);
-    return true;
-}
+const char *const USAGE = "Usage: scaninc [-I INCLUDE_PATH]... [-C CACHE_PATH] [-M DEPENDENCY_OUT_PATH] FILE_PATH [[-M DEPENDENCY_OUT_PATH] FILE_PATH]...\n";
 
-const char *const USAGE = "Usage: scaninc [-I INCLUDE_PATH] [-M DEPENDENCY_OUT_PATH] FILE_PATH\n";
+struct ScanTarget
+{
+    std::string path;
+    bool makeformat;
+    std::string make_outfile;
+};
 
-int main(int argc, char **argv)
+static void ScanDependencies(ScanCache& cache, std::vector<std::string> includeDirs, const ScanTarget& target)
 {
     std::queue<std::string> filesToProcess;
     std::set<std::string> dependencies;
     std::set<std::string> dependencies_includes;
 
-    std::vector<std::string> includeDirs;
-
-    bool makeformat = false;
-    std::string make_outfile;
-
-    argc--;
-    argv++;
-
-    while (argc > 1)
-    {
-        std::string arg(argv[0]);
-        if (arg.substr(0, 2) == "-I")
-        {
-            std::string includeDir = arg.substr(2);
-            if (includeDir.empty())
-            {
-                argc--;
-                argv++;
-                includeDir = std::string(argv[0]);
-            }
-            if (!includeDir.empty() && includeDir.back() != '/')
-            {
-                includeDir += '/';
-            }
-            includeDirs.push_back(includeDir);
-        }
-        else if(arg.substr(0, 2) == "-M")
-        {
-            makeformat = true;
-            argc--;
-            argv++;
-            make_outfile = std::string(argv[0]);
-        }
-        else
-        {
-            FATAL_ERROR(USAGE);
-        }
-        argc--;
-        argv++;
-    }
-
-    if (argc != 1) {
-        FATAL_ERROR(USAGE);
-    }
-
-    std::string initialPath(argv[0]);
-
-    filesToProcess.push(initialPath);
+    filesToProcess.push(target.path);
 
     while (!filesToProcess.empty())
     {
         std::string filePath = filesToProcess.front();
-        SourceFile file(filePath);
+        SourceFileType fileType = GetFileType(filePath);
+        const ScannedFile& file = cache.Scan(filePath);
         filesToProcess.pop();
 
-        includeDirs.push_back(file.GetSrcDir());
-        for (auto incbin : file.GetIncbins())
+        includeDirs.push_back(GetDir(filePath));
+        for (auto incbin : file.incbins)
         {
             dependencies.insert(incbin);
         }
-        for (auto include : file.GetIncludes())
+        for (auto include : file.includes)
         {
             bool exists = false;
             std::string path("");
             for (auto includeDir : includeDirs)
             {
                 path = includeDir + include;
-                if (CanOpenFile(path))
+                if (cache.CanOpenFile(path))
                 {
                     exists = true;
                     break;
                 }
             }
-            if (!exists && (file.FileType() == SourceFileType::Asm || file.FileType() == SourceFileType::Inc))
+            if (!exists && (fileType == SourceFileType::Asm || fileType == SourceFileType::Inc))
             {
                 path = include;
-                if (CanOpenFile(path))
+                if (cache.CanOpenFile(path))
                     exists = true;
             }
             if (!exists)
@@ -141,7 +92,7 @@ int main(int argc, char **argv)
         includeDirs.pop_back();
     }
 
-    if(!makeformat)
+    if(!target.makeformat)
     {
         for (const std::string &path : dependencies)
         {
@@ -152,6 +103,7 @@ int main(int argc, char **argv)
     else
     {
         // Write out make rules to a file
+        const std::string& make_outfile = target.make_outfile;
         std::ofstream output(make_outfile);
 
         // Print a make rule for the object file
@@ -184,3 +136,83 @@ int main(int argc, char **argv)
         output.close();
     }
 }
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> includeDirs;
+    std::vector<ScanTarget> targets;
+    std::string cachePath;
+
+    bool makeformat = false;
+    std::string make_outfile;
+
+    argc--;
+    argv++;
+
+    while (argc > 0)
+    {
+        std::string arg(argv[0]);
+        if (arg.substr(0, 2) == "-I")
+        {
+            std::string includeDir = arg.substr(2);
+            if (includeDir.empty())
+            {
+                if (argc < 2)
+                    FATAL_ERROR(USAGE);
+                argc--;
+                argv++;
+                includeDir = std::string(argv[0]);
+            }
+            if (!includeDir.empty() && includeDir.back() != '/')
+            {
+                includeDir += '/';
+            }
+            includeDirs.push_back(includeDir);
+        }
+        else if(arg.substr(0, 2) == "-M")
+        {
+            if (argc < 2)
+                FATAL_ERROR(USAGE);
+            makeformat = true;
+            argc--;
+            argv++;
+            make_outfile = std::string(argv[0]);
+        }
+        else if(arg.substr(0, 2) == "-C")
+        {
+            if (argc < 2)
+                FATAL_ERROR(USAGE);
+            argc--;
+            argv++;
+            cachePath = std::string(argv[0]);
+        }
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            // Each -M applies to the file path that follows it.
+            targets.push_back(ScanTarget{arg, makeformat, make_outfile});
+            makeformat = false;
+            make_outfile.clear();
+        }
+        else
+        {
+            FATAL_ERROR(USAGE);
+        }
+        argc--;
+        argv++;
+    }
+
+    if (targets.empty() || makeformat) {
+        FATAL_ERROR(USAGE);
+    }
+
+    ScanCache cache;
+
+    if (!cachePath.empty())
+        cache.Load(cachePath);
+
+    for (const ScanTarget& target : targets)
+        ScanDependencies(cache, includeDirs, target);
+
+    if (!cachePath.empty())
+        cache.Save(cachePath);
+}
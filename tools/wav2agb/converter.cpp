@@ -4,6 +4,9 @@
 #include <fstream>
 #include <algorithm>
 #include <vector>
+#include <thread>
+#include <atomic>
+#include <limits>
 
 #include <cmath>
 #include <cstdarg>
@@ -150,44 +153,84 @@ static const std::vector<std::vector<size_t>> dpcmFastLookupTable = {
 
 static int squared(int x) { return x * x; }
 
-static void dpcm_lookahead(
-        int& minimumError, size_t& minimumErrorIndex,
-        const double *sampleBuf, const size_t lookahead, const int prevLevel)
-{
-    if (lookahead == 0) {
-        minimumError = 0;
-        return;
+static const size_t DPCM_MAX_LOOKAHEAD = 8;
+static const int DPCM_NUM_LEVELS = 256;
+
+// Exhaustive search over the next `lookahead` samples for the index sequence with the
+// smallest squared error. The best error reachable from a (depth, level) pair does not
+// depend on how that level was reached, so it is memoized per search window, which turns
+// the 16^lookahead tree walk into at most lookahead * 256 * 16 steps. Candidates are still
+// visited in the same order with the same strict comparison, so the chosen index is the
+// same as for the plain recursive search.
+class dpcm_searcher {
+public:
+    void reset(const double *sampleBuf, size_t lookahead)
+    {
+        this->lookahead = lookahead;
+        for (size_t i = 0; i < lookahead; i++)
+            samples[i] = clamp(static_cast<int>(floor(sampleBuf[i] * 128.0)), -128, 127);
+        // a new generation invalidates all memoized errors of the previous window
+        if (++generation == 0) {
+            std::fill(&memoGeneration[0][0], &memoGeneration[0][0] + sizeof(memoGeneration) / sizeof(memoGeneration[0][0]), 0);
+            generation = 1;
+        }
+    }
+
+    void search(int& minimumError, size_t& minimumErrorIndex, const int prevLevel)
+    {
+        minimumError = search(0, prevLevel, minimumErrorIndex);
     }
 
-    minimumError = std::numeric_limits<int>::max();
-    minimumErrorIndex = dpcmLookupTable.size();
-    const int s = clamp(static_cast<int>(floor(sampleBuf[0] * 128.0)), -128, 127);
-    const std::vector<size_t> indexCandicateSet = dpcm_lookahead_fast? dpcmFastLookupTable[s - prevLevel + 255]: dpcmIndexTable;
+private:
+    int search(size_t depth, int prevLevel, size_t& minimumErrorIndex)
+    {
+        minimumErrorIndex = dpcmLookupTable.size();
 
-    for (auto i : indexCandicateSet) {
-        int newLevel = prevLevel + dpcmLookupTable[i];
+        if (depth == lookahead)
+            return 0;
 
-        int recMinimumError;
-        size_t recMinimumErrorIndex;
+        const size_t levelIndex = static_cast<size_t>(prevLevel + 128);
+        if (depth > 0 && memoGeneration[depth][levelIndex] == generation)
+            return memoError[depth][levelIndex];
 
-        // TODO apply dither noise
-        int errorEstimation = squared(s - newLevel);
-        if (errorEstimation >= minimumError)
-            continue;
+        int minimumError = std::numeric_limits<int>::max();
+        const int s = samples[depth];
+        const std::vector<size_t>& indexCandidateSet = dpcm_lookahead_fast ? dpcmFastLookupTable[s - prevLevel + 255] : dpcmIndexTable;
+
+        for (auto i : indexCandidateSet) {
+            int newLevel = prevLevel + dpcmLookupTable[i];
+            if (newLevel > 127 || newLevel < -128)
+                continue;
 
-        dpcm_lookahead(recMinimumError, recMinimumErrorIndex,
-                sampleBuf + 1, lookahead - 1, newLevel);
+            // TODO apply dither noise
+            int errorEstimation = squared(s - newLevel);
+            if (errorEstimation >= minimumError)
+                continue;
 
-        // TODO weigh the error squared
-        int error = squared(s - newLevel) + recMinimumError;
-        if (error < minimumError) {
-            if (newLevel <= 127 && newLevel >= -128) {
+            size_t recMinimumErrorIndex;
+            int recMinimumError = search(depth + 1, newLevel, recMinimumErrorIndex);
+            if (recMinimumError == std::numeric_limits<int>::max())
+                continue;
+
+            // TODO weigh the error squared
+            int error = errorEstimation + recMinimumError;
+            if (error < minimumError) {
                 minimumError = error;
                 minimumErrorIndex = i;
             }
         }
+
+        memoGeneration[depth][levelIndex] = generation;
+        memoError[depth][levelIndex] = minimumError;
+        return minimumError;
     }
-}
+
+    size_t lookahead = 0;
+    int samples[DPCM_MAX_LOOKAHEAD];
+    uint32_t generation = 0;
+    uint32_t memoGeneration[DPCM_MAX_LOOKAHEAD][DPCM_NUM_LEVELS] = {};
+    int memoError[DPCM_MAX_LOOKAHEAD][DPCM_NUM_LEVELS];
+};
 
 static double calculate_snr(const std::vector<double>& uncompressedData, const std::vector<int>& decompressedData)
 {
@@ -210,71 +253,108 @@ static double calculate_snr(const std::vector<double>& uncompressedData, const s
     return 10 * std::log10((double)sum_son / sum_mum);
 }
 
-template<typename InitialSampleWriter, typename CompressedDataWriter>
-static void convert_dpcm_impl(wav_file& wf, InitialSampleWriter writeInitialSample, CompressedDataWriter writeCompressedData)
+struct dpcm_block {
+    int initialSample;
+    std::vector<uint8_t> compressedData;
+    std::vector<int> decompressedData;
+};
+
+// Each block starts from its own uncompressed sample and the lookahead never
+// crosses a block boundary, so blocks can be encoded independently.
+static void encode_dpcm_block(const double *ds, size_t samples_in_block, dpcm_searcher& searcher, dpcm_block& block)
 {
     int minimumError;
     size_t minimumErrorIndex;
 
-    std::vector<double> uncompressedData;
-    std::vector<int> decompressedData;
+    // TODO apply dither noise
+    int s = clamp(static_cast<int>(floor(ds[0] * 128.0)), -128, 127);
 
-    const auto startTime = std::chrono::high_resolution_clock::now();
+    block.initialSample = s;
+    if (dpcm_verbose) {
+        block.decompressedData.push_back(s);
+    }
 
-    for (size_t i = 0; i < wf.loopEnd; i += DPCM_BLK_SIZE) {
-        double ds[DPCM_BLK_SIZE];
-        size_t samples_in_block = std::min(DPCM_BLK_SIZE, wf.loopEnd - i);
-        wf.readData(i, ds, samples_in_block);
-        // Pad remaining samples in block with zeros if needed
-        for (size_t j = samples_in_block; j < DPCM_BLK_SIZE; j++) {
-            ds[j] = 0.0;
-        }
+    size_t innerLoopCount = 1;
+    size_t samples_to_process = dpcm_include_padding ? DPCM_BLK_SIZE : samples_in_block;
+    uint8_t outData = 0;
+    size_t sampleBufReadLen;
+
+    goto initial_loop_enter;
+
+    do {
+        if (innerLoopCount >= samples_to_process)
+            break;
+        sampleBufReadLen = std::min(dpcm_enc_lookahead, DPCM_BLK_SIZE - innerLoopCount);
+        searcher.reset(&ds[innerLoopCount], sampleBufReadLen);
+        searcher.search(minimumError, minimumErrorIndex, s);
+        outData = static_cast<uint8_t>((minimumErrorIndex & 0xF) << 4);
+        s += dpcmLookupTable[minimumErrorIndex];
         if (dpcm_verbose) {
-            uncompressedData.insert(uncompressedData.end(), std::begin(ds), std::end(ds));
+            block.decompressedData.push_back(s);
         }
-        // TODO apply dither noise
-        int s = clamp(static_cast<int>(floor(ds[0] * 128.0)), -128, 127);
-
-        writeInitialSample(s);
+        innerLoopCount += 1;
+initial_loop_enter:
+        if (innerLoopCount >= samples_to_process)
+            break;
+        sampleBufReadLen = std::min(dpcm_enc_lookahead, DPCM_BLK_SIZE - innerLoopCount);
+        searcher.reset(&ds[innerLoopCount], sampleBufReadLen);
+        searcher.search(minimumError, minimumErrorIndex, s);
+        outData |= static_cast<uint8_t>(minimumErrorIndex & 0xF);
+        s += dpcmLookupTable[minimumErrorIndex];
+        innerLoopCount += 1;
         if (dpcm_verbose) {
-            decompressedData.push_back(s);
+            block.decompressedData.push_back(s);
         }
+        block.compressedData.push_back(outData);
+    } while (innerLoopCount < DPCM_BLK_SIZE);
+}
 
-        size_t innerLoopCount = 1;
-        size_t samples_to_process = dpcm_include_padding ? DPCM_BLK_SIZE : samples_in_block;
-        uint8_t outData = 0;
-        size_t sampleBufReadLen;
-
-        goto initial_loop_enter;
-
-        do {
-            if (innerLoopCount >= samples_to_process)
-                break;
-            sampleBufReadLen = std::min(dpcm_enc_lookahead, DPCM_BLK_SIZE - innerLoopCount);
-            dpcm_lookahead(
-                    minimumError, minimumErrorIndex,
-                    &ds[innerLoopCount], sampleBufReadLen, s);
-            outData = static_cast<uint8_t>((minimumErrorIndex & 0xF) << 4);
-            s += dpcmLookupTable[minimumErrorIndex];
-            if (dpcm_verbose) {
-                decompressedData.push_back(s);
-            }
-            innerLoopCount += 1;
-initial_loop_enter:
-            if (innerLoopCount >= samples_to_process)
-                break;
-            sampleBufReadLen = std::min(dpcm_enc_lookahead, DPCM_BLK_SIZE - innerLoopCount);
-            dpcm_lookahead(
-                    minimumError, minimumErrorIndex,
-                    &ds[innerLoopCount], sampleBufReadLen, s);
-            outData |= static_cast<uint8_t>(minimumErrorIndex & 0xF);
-            s += dpcmLookupTable[minimumErrorIndex];
-            innerLoopCount += 1;
-            if (dpcm_verbose) {
-                decompressedData.push_back(s);
-            }
+template<typename InitialSampleWriter, typename CompressedDataWriter>
+static void convert_dpcm_impl(wav_file& wf, InitialSampleWriter writeInitialSample, CompressedDataWriter writeCompressedData)
+{
+    std::vector<double> uncompressedData;
+    std::vector<int> decompressedData;
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    const size_t numBlocks = (wf.loopEnd + DPCM_BLK_SIZE - 1) / DPCM_BLK_SIZE;
+    // Pad remaining samples in the last block with zeros if needed
+    std::vector<double> samples(numBlocks * DPCM_BLK_SIZE, 0.0);
+    std::vector<dpcm_block> blocks(numBlocks);
+
+    for (size_t i = 0; i < numBlocks; i++) {
+        size_t samples_in_block = std::min(DPCM_BLK_SIZE, wf.loopEnd - i * DPCM_BLK_SIZE);
+        wf.readData(i * DPCM_BLK_SIZE, &samples[i * DPCM_BLK_SIZE], samples_in_block);
+    }
+
+    if (dpcm_verbose) {
+        uncompressedData = samples;
+    }
+
+    std::atomic<size_t> nextBlock(0);
+    auto encodeBlocks = [&]() {
+        dpcm_searcher searcher;
+        for (size_t i = nextBlock++; i < numBlocks; i = nextBlock++) {
+            size_t samples_in_block = std::min(DPCM_BLK_SIZE, wf.loopEnd - i * DPCM_BLK_SIZE);
+            encode_dpcm_block(&samples[i * DPCM_BLK_SIZE], samples_in_block, searcher, blocks[i]);
+        }
+    };
+
+    const size_t numThreads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), numBlocks);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; i++)
+        threads.emplace_back(encodeBlocks);
+    encodeBlocks();
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const dpcm_block& block : blocks) {
+        writeInitialSample(block.initialSample);
+        for (uint8_t outData : block.compressedData)
             writeCompressedData(outData);
-        } while (innerLoopCount < DPCM_BLK_SIZE);
+        if (dpcm_verbose) {
+            decompressedData.insert(decompressedData.end(), block.decompressedData.begin(), block.decompressedData.end());
+        }
     }
 
     const auto endTime = std::chrono::high_resolution_clock::now();
@@ -318,7 +398,7 @@ void disable_dpcm_padding()
 
 void set_dpcm_lookahead(size_t lookahead)
 {
-    dpcm_enc_lookahead = clamp<size_t>(lookahead, 1, 8);
+    dpcm_enc_lookahead = clamp<size_t>(lookahead, 1, DPCM_MAX_LOOKAHEAD);
 }
 
 void set_wav_loop_start(uint32_t start)